@@ -0,0 +1,46 @@
+/*
+ Basic ESPiLight asynchronous transmit example
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define TRANSMITTER_PIN 13
+
+ESPiLight rf(TRANSMITTER_PIN);
+
+bool on = true;
+unsigned long lastSend = 0;
+int onCommand, offCommand;
+
+void setup() {
+  Serial.begin(115200);
+  // encode the messages once
+  onCommand = ESPiLight::registerCommand(
+      "elro_800_switch", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}");
+  offCommand = ESPiLight::registerCommand(
+      "elro_800_switch", "{\"systemcode\":17,\"unitcode\":1,\"off\":1}");
+  // send every edge at its deadline from the start of the frame
+  ESPiLight::setPreciseTimingEnabled(true);
+  // called from rf.loop() after the transmission is completed
+  rf.setTransmitCallback([](int handle) {
+    Serial.print("sent ");
+    Serial.print(handle);
+    // largest edge error of the frames of this transmission
+    Serial.print(", timing error [us]: ");
+    Serial.println(ESPiLight::transmitTiming(true).max_error);
+  });
+}
+
+// Toggle state of elro 800 switch evrey 2 s, without blocking loop()
+void loop() {
+  if (!rf.transmitting() && millis() - lastSend > 2000) {
+    int handle = rf.sendCommandAsync(on ? onCommand : offCommand);
+    Serial.print("sending ");
+    Serial.println(handle);
+    on = !on;
+    lastSend = millis();
+  }
+  rf.loop();
+}
@@ -0,0 +1,48 @@
+/*
+ ESPiLight example with several transmitters
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+// transmitter in the house
+#define HOUSE_PIN 13
+// two transmitters in the garage, driven with the same signal
+const uint8_t GARAGE_PINS[] = {4, 5};
+
+ESPiLight house(HOUSE_PIN);
+ESPiLight garage(GARAGE_PINS, sizeof(GARAGE_PINS));
+
+bool on = true;
+unsigned long lastSend = 0;
+
+void setup() {
+  Serial.begin(115200);
+  // called from house.loop() for the transmissions of both instances
+  house.setTransmitCallback([](int handle) {
+    Serial.print("sent ");
+    Serial.println(handle);
+  });
+}
+
+// Toggle a switch in the house and one in the garage every 2 s. Both share
+// the queue of the transmitter and are sent at the same time.
+void loop() {
+  if (!house.transmitting() && millis() - lastSend > 2000) {
+    const char *state = on ? "\"on\":1}" : "\"off\":1}";
+    int handle = house.sendAsync(
+        "elro_800_switch",
+        String("{\"systemcode\":17,\"unitcode\":1,") + state);
+    Serial.print("sending ");
+    Serial.println(handle);
+    handle = garage.sendAsync(
+        "elro_800_switch",
+        String("{\"systemcode\":17,\"unitcode\":2,") + state);
+    Serial.print("sending ");
+    Serial.println(handle);
+    on = !on;
+    lastSend = millis();
+  }
+  house.loop();
+}
@@ -22,8 +22,10 @@ void setup() {
       "279,2511,1395,9486@",
       codes, MAXPULSESTREAMLENGTH);
 
-  // transmit the pulse train
-  rf.sendPulseTrain(codes, length);
+  // transmit the pulse train, it is sent exactly or not at all
+  if (rf.sendPulseTrain(codes, length) < 0) {
+    Serial.println("pulse train can not be sent exactly");
+  }
 }
 
 // Toggle state of elro 800 switch evrey 2 s
@@ -17,7 +17,9 @@
 */
 
 #include <ESPiLight.h>
+#include <algorithm>
 #include "tools/aprintf.h"
+#include "tools/transmitter.h"
 
 // ESP32 doesn't define ICACHE_RAM_ATTR
 #ifndef ICACHE_RAM_ATTR
@@ -33,14 +35,55 @@
 #endif
 
 extern "C" {
+#include "pilight/libs/pilight/core/log.h"
 #include "pilight/libs/pilight/core/pilight.h"
 #include "pilight/libs/pilight/protocols/protocol.h"
 }
 
 static protocols_t *used_protocols = nullptr;
 
+#define CANONICAL_STRING 0x1
+#define CANONICAL_ESCAPE 0x2
+
+// Size of the unescaped keys and strings of a flat command
+#define COMMAND_STRINGS_SIZE 96
+
+typedef struct tx_cache_t {
+  protocol_t *protocol;  // nullptr marks a free entry
+  char *json;            // canonical json message
+  uint32_t hash;
+  uint32_t used;  // for least recently used replacement
+  bool pinned;    // registered command, never replaced
+  CompactPulseTrain_t frame;
+} tx_cache_t;
+
+static tx_cache_t tx_cache[TX_CACHE_SIZE];
+static uint32_t tx_cache_used = 0;
+
+typedef struct echo_pending_t {
+  int handle;  // 0 marks a free entry
+  protocol_t *protocol;
+  char *expected;  // message decoded from the sent pulse train
+  unsigned long start;
+  uint32_t latency;
+  uint8_t echoes;
+  uint8_t limit;
+} echo_pending_t;
+
+typedef struct echo_stats_t {
+  protocol_t *protocol;  // nullptr marks a free entry
+  EchoStats_t stats;
+} echo_stats_t;
+
+static echo_pending_t echo_pending[TX_QUEUE_SIZE];
+static echo_stats_t echo_stats[ECHO_STATS_SIZE];
+
 volatile PulseTrain_t ESPiLight::_pulseTrains[RECEIVER_BUFFER_SIZE];
 bool ESPiLight::_enabledReceiver;
+volatile bool ESPiLight::_receiverState = false;
+bool ESPiLight::_echoTransmit = false;
+volatile unsigned long ESPiLight::_deafSince = 0;
+volatile uint32_t ESPiLight::_deafTime = 0;
 volatile uint8_t ESPiLight::_actualPulseTrain = 0;
 volatile unsigned long ESPiLight::_lastChange = 0;  // Timestamp of previous edge
 volatile unsigned long ESPiLight::_lastPulse = 0;  // Timestamp of last pulse
@@ -54,7 +97,19 @@ uint32_t ESPiLight::maxgaplen = std::numeric_limits<uint16_t>::min();
 uint16_t ESPiLight::minpulselen = 300;
 uint16_t ESPiLight::maxpulselen = 16000;
 
-static void fire_callback(protocol_t *protocol, ESPiLightCallBack callback);
+/**
+ * Receivers of the decoded messages of an instance.
+ */
+typedef struct message_sink_t {
+  const ESPiLightCallBack *callback;
+  const MessageCallBack *messageCallback;
+  char *buffer;
+  size_t size;
+  Print *output;
+} message_sink_t;
+
+static void fire_callback(const message_sink_t *sink, const char *protocol,
+                          JsonNode *message, int status, size_t repeats);
 static void calc_lengths();
 
 static protocols_t *get_protocols() {
@@ -96,12 +151,34 @@ static int create_pulse_train(uint16_t *pulses, protocol_t *protocol,
                               const String &content) {
   Debug("piLightCreatePulseTrain: ");
 
-  if (!json_validate(content.c_str())) {
-    Debug("invalid json: ");
+  // flat commands are read onto the stack, others into the arena, which
+  // also holds the message of createCode()
+  JsonNode nodes[MAX_PILIGHT_ARGS + 1];
+  char strings[COMMAND_STRINGS_SIZE];
+  JsonNode *tree = nullptr;
+  JsonError error;
+  json_arena_begin(0);
+  JsonNode *message =
+      json_parse_flat(content.c_str(), nodes, MAX_PILIGHT_ARGS + 1, strings,
+                      sizeof(strings), &error);
+  if (message == nullptr && error.code == JSON_ERROR_LIMIT) {
+    tree = json_parse(content.c_str(), &error);
+    message = tree;
+  }
+  if (message == nullptr) {
+    json_arena_end();
+    if (error.code == JSON_ERROR_MEMORY) {
+      DebugLn("out of memory");
+      return ESPiLight::ERROR_OUT_OF_MEMORY;
+    }
+    Debug("invalid json at ");
+    Debug(error.position);
+    Debug(": ");
     DebugLn(content);
     return ESPiLight::ERROR_INVALID_JSON;
   }
 
+  int return_value = ESPiLight::ERROR_UNAVAILABLE_PROTOCOL;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtype-limits"
   if ((protocol != nullptr) && (protocol->createCode != nullptr) &&
@@ -112,22 +189,345 @@ static int create_pulse_train(uint16_t *pulses, protocol_t *protocol,
 
     protocol->rawlen = 0;
     protocol->raw = pulses;
-    JsonNode *message = json_decode(content.c_str());
-    int return_value = protocol->createCode(message);
-    json_delete(message);
+    if (protocol->createCode(message) == EXIT_SUCCESS) {
+      DebugLn(" create Code succeded.");
+      return_value = protocol->rawlen;
+    } else {
+      DebugLn(" create Code failed.");
+      return_value = ESPiLight::ERROR_INVALID_PILIGHT_MSG;
+    }
     // delete message created by createCode()
     json_delete(protocol->message);
     protocol->message = nullptr;
+  }
+  json_arena_end();
+  json_delete(tree);
+  return return_value;
+}
+
+/**
+ * Run parseCode() of protocol with its message in an arena. A message, which
+ * lost members to a failed allocation, is dropped.
+ */
+static void parse_code(protocol_t *protocol) {
+  JsonPoolStats before;
+  JsonPoolStats after;
+
+  json_pool_stats(&before, false);
+  protocol->message = nullptr;
+  json_arena_begin(0);
+  protocol->parseCode();
+  json_arena_end();
+  json_pool_stats(&after, false);
+  if (after.failures != before.failures && protocol->message != nullptr) {
+    DebugLn("out of memory, message dropped");
+    json_delete(protocol->message);
+    protocol->message = nullptr;
+  }
+}
 
-    if (return_value == EXIT_SUCCESS) {
-      DebugLn(" create Code succeded.");
-      return protocol->rawlen;
-    } else {
-      DebugLn(" create Code failed.");
-      return ESPiLight::ERROR_INVALID_PILIGHT_MSG;
+/**
+ * Return the next character of json, skipping whitespace outside of
+ * strings, or '\0' at the end. state tracks strings and escapes.
+ */
+static char canonical_next(const char **json, uint8_t *state) {
+  char c;
+  while ((c = **json) != '\0') {
+    (*json)++;
+    if (*state & CANONICAL_STRING) {
+      if (*state & CANONICAL_ESCAPE) {
+        *state &= (uint8_t)~CANONICAL_ESCAPE;
+      } else if (c == '\\') {
+        *state |= CANONICAL_ESCAPE;
+      } else if (c == '"') {
+        *state &= (uint8_t)~CANONICAL_STRING;
+      }
+      return c;
+    }
+    if (c == '"') {
+      *state |= CANONICAL_STRING;
+      return c;
+    }
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+      return c;
+    }
+  }
+  return '\0';
+}
+
+/**
+ * FNV-1a hash of protocol and the canonical form of json. Stores the
+ * canonical form to canonical, if not nullptr.
+ */
+static uint32_t canonical_hash(const char *protocol, const char *json,
+                               size_t *length, char *canonical) {
+  uint32_t hash = 2166136261u;
+  uint8_t state = 0;
+  char c;
+
+  while ((c = *protocol++) != '\0') {
+    hash = (hash ^ (uint8_t)c) * 16777619u;
+  }
+  hash = (hash ^ (uint8_t)':') * 16777619u;
+  *length = 0;
+  while ((c = canonical_next(&json, &state)) != '\0') {
+    hash = (hash ^ (uint8_t)c) * 16777619u;
+    if (canonical != nullptr) {
+      canonical[*length] = c;
+    }
+    (*length)++;
+  }
+  if (canonical != nullptr) {
+    canonical[*length] = '\0';
+  }
+  return hash;
+}
+
+static bool canonical_equal(const char *json, const char *canonical) {
+  uint8_t state = 0;
+  char c;
+
+  while ((c = canonical_next(&json, &state)) != '\0') {
+    if (c != *canonical++) {
+      return false;
+    }
+  }
+  return *canonical == '\0';
+}
+
+static const tx_cache_t *find_command(int command) {
+  if (command <= 0 || command > TX_CACHE_SIZE ||
+      !tx_cache[command - 1].pinned) {
+    return nullptr;
+  }
+  return &tx_cache[command - 1];
+}
+
+/**
+ * Return the cache entry with the pulse train of protocol and json. On a
+ * miss, the least recently used entry, which is not pinned, is replaced by
+ * a new pulse train. It is kept, if the pulse train cannot be created. At
+ * least one entry is never pinned.
+ */
+static const tx_cache_t *cache_pulse_train(const String &protocol,
+                                           const String &json, bool pin,
+                                           int *error) {
+  size_t length = 0;
+  const uint32_t hash =
+      canonical_hash(protocol.c_str(), json.c_str(), &length, nullptr);
+  tx_cache_t *hit = nullptr;
+  tx_cache_t *victim = nullptr;
+  uint8_t pinned = 0;
+
+  tx_cache_used++;
+  for (uint8_t i = 0; i < TX_CACHE_SIZE; i++) {
+    tx_cache_t *entry = &tx_cache[i];
+    if (hit == nullptr && entry->protocol != nullptr && entry->hash == hash &&
+        strcmp(entry->protocol->id, protocol.c_str()) == 0 &&
+        canonical_equal(json.c_str(), entry->json)) {
+      hit = entry;
+    }
+    if (entry->pinned) {
+      pinned++;
+    } else if (victim == nullptr || entry->protocol == nullptr ||
+               (victim->protocol != nullptr && entry->used < victim->used)) {
+      victim = entry;
     }
   }
-  return ESPiLight::ERROR_UNAVAILABLE_PROTOCOL;
+  if (hit != nullptr) {
+    // pinning the hit must not take the last entry, which is not pinned
+    if (pin && !hit->pinned && pinned + 1 >= TX_CACHE_SIZE) {
+      *error = ESPiLight::ERROR_CACHE_FULL;
+      return nullptr;
+    }
+    hit->used = tx_cache_used;
+    hit->pinned = hit->pinned || pin;
+    return hit;
+  }
+  if (victim == nullptr || (pin && pinned + 1 >= TX_CACHE_SIZE)) {
+    *error = ESPiLight::ERROR_CACHE_FULL;
+    return nullptr;
+  }
+
+  protocol_t *protocol_listener = find_protocol(protocol.c_str());
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  const int rawlen = create_pulse_train(pulses, protocol_listener, json);
+  if (rawlen <= 0) {
+    *error = rawlen;
+    return nullptr;
+  }
+  char *canonical = (char *)MALLOC(length + 1);
+  if (canonical == nullptr) {
+    *error = ESPiLight::ERROR_OUT_OF_MEMORY;
+    return nullptr;
+  }
+  canonical_hash(protocol.c_str(), json.c_str(), &length, canonical);
+  if (victim->json != nullptr) {
+    FREE(victim->json);
+  }
+  victim->json = canonical;
+  tx_frame_encode(&victim->frame, pulses, (size_t)rawlen);
+  /*
+  DebugLn();
+  Debug("send: ");
+  Debug(rawlen);
+  Debug(" pulses (");
+  Debug(protocol);
+  Debug(", ");
+  Debug(json);
+  DebugLn(")");
+  */
+  victim->protocol = protocol_listener;
+  victim->hash = hash;
+  victim->used = tx_cache_used;
+  victim->pinned = pin;
+  return victim;
+}
+
+/**
+ * Return the message protocol decodes from frame, or nullptr. Must be
+ * freed with json_free().
+ */
+static char *decode_frame(protocol_t *protocol,
+                          const CompactPulseTrain_t *frame) {
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  char *content = nullptr;
+
+  if (protocol->parseCode == nullptr || protocol->validate == nullptr) {
+    return nullptr;
+  }
+  protocol->raw = pulses;
+  protocol->rawlen = (int)tx_frame_decode(frame, pulses);
+  log_mute++;
+  if (protocol->validate() == 0) {
+    parse_code(protocol);
+    if (protocol->message != nullptr) {
+      content = json_encode(protocol->message);
+      json_delete(protocol->message);
+      protocol->message = nullptr;
+    }
+  }
+  log_mute--;
+  return content;
+}
+
+static bool echo_verifying() {
+  for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
+    if (echo_pending[i].handle != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void start_echo(int handle, protocol_t *protocol,
+                       const CompactPulseTrain_t *frame, uint8_t limit) {
+  for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
+    echo_pending_t *pending = &echo_pending[i];
+    if (pending->handle != 0) {
+      continue;
+    }
+    pending->expected = decode_frame(protocol, frame);
+    if (pending->expected == nullptr) {
+      return;
+    }
+    pending->handle = handle;
+    pending->protocol = protocol;
+    pending->start = tx_micros();
+    pending->latency = 0;
+    pending->echoes = 0;
+    pending->limit = limit;
+    return;
+  }
+}
+
+/**
+ * Count the decoded message of protocol as echo of a pending transmission
+ * of the same message. Drops the remaining repeats, once enough echoes
+ * are verified.
+ */
+static void verify_echo(protocol_t *protocol) {
+  char *content = nullptr;
+
+  for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
+    echo_pending_t *pending = &echo_pending[i];
+    if (pending->handle == 0 || pending->protocol != protocol) {
+      continue;
+    }
+    if (content == nullptr) {
+      content = json_encode(protocol->message);
+      if (content == nullptr) {
+        return;
+      }
+    }
+    if (strcmp(content, pending->expected) != 0) {
+      continue;
+    }
+    if (pending->echoes == 0) {
+      pending->latency = (uint32_t)(tx_micros() - pending->start);
+    }
+    if (pending->echoes < std::numeric_limits<uint8_t>::max()) {
+      pending->echoes++;
+    }
+    if (pending->echoes == pending->limit) {
+      tx_abort(pending->handle);
+    }
+    break;
+  }
+  if (content != nullptr) {
+    json_free(content);
+  }
+}
+
+static echo_stats_t *find_echo_stats(const char *name, bool create) {
+  for (uint8_t i = 0; i < ECHO_STATS_SIZE; i++) {
+    if (echo_stats[i].protocol != nullptr &&
+        strcmp(echo_stats[i].protocol->id, name) == 0) {
+      return &echo_stats[i];
+    }
+  }
+  if (!create) {
+    return nullptr;
+  }
+  for (uint8_t i = 0; i < ECHO_STATS_SIZE; i++) {
+    if (echo_stats[i].protocol == nullptr) {
+      return &echo_stats[i];
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Account the pending transmission of handle (or every completed one, if
+ * handle is 0) to the echo statistics.
+ */
+static void finish_echo(int handle) {
+  for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
+    echo_pending_t *pending = &echo_pending[i];
+    if (pending->handle == 0 ||
+        (handle == 0 ? tx_pending(pending->handle)
+                     : pending->handle != handle)) {
+      continue;
+    }
+    echo_stats_t *entry = find_echo_stats(pending->protocol->id, true);
+    if (entry != nullptr) {
+      EchoStats_t *stats = &entry->stats;
+      entry->protocol = pending->protocol;
+      stats->transmissions++;
+      if (pending->echoes > 0) {
+        stats->confirmed++;
+        stats->echoes += pending->echoes;
+        stats->latency = (uint32_t)(
+            (int32_t)stats->latency +
+            ((int32_t)pending->latency - (int32_t)stats->latency) /
+                (int32_t)stats->confirmed);
+        stats->maxLatency = std::max(stats->maxLatency, pending->latency);
+      }
+    }
+    json_free(pending->expected);
+    pending->expected = nullptr;
+    pending->handle = 0;
+  }
 }
 
 static void calc_lengths() {
@@ -234,12 +634,18 @@ void ICACHE_RAM_ATTR ESPiLight::interruptHandler() {
   if (!_enabledReceiver) {
     return;
   }
+  receiveEdge(micros());
+}
+
+void ICACHE_RAM_ATTR ESPiLight::receiveEdge(unsigned long now) {
+  if (!_enabledReceiver) {
+    return;
+  }
 
   volatile PulseTrain_t &pulseTrain = _pulseTrains[_actualPulseTrain];
   volatile uint16_t *codes = pulseTrain.pulses;
 
   if (pulseTrain.length == 0) {
-    const unsigned long now = micros();
     const unsigned int duration = now - _lastPulse;
     const unsigned int durationChange = now - _lastChange;
 
@@ -250,6 +656,13 @@ void ICACHE_RAM_ATTR ESPiLight::interruptHandler() {
 
     // detect end
     if(duration >= mingaplen) {
+      // the gap is the footer of the frame
+      if (_nrpulses > 0 && duration <= maxgaplen &&
+          duration <= std::numeric_limits<uint16_t>::max() &&
+          _nrpulses < MAXPULSESTREAMLENGTH - 1) {
+        codes[_nrpulses] = (uint16_t)duration;
+        _nrpulses = (uint8_t)(_nrpulses + 1);
+      }
       if (_nrpulses >= minrawlen && _nrpulses <= maxrawlen) {
             pulseTrain.length = _nrpulses;
             pulseTrain.ok = false;
@@ -309,8 +722,6 @@ void ESPiLight::disableReceiver() { _enabledReceiver = false; }
 
 
 void ESPiLight::loop() {
-  int length = 0;
-  uint16_t pulses[MAXPULSESTREAMLENGTH];
 #ifdef SHOW_IRQ_RAW
   if(_lastDurationPrint != _lastDuration) {
     DebugLn(_lastDuration);
@@ -318,9 +729,26 @@ void ESPiLight::loop() {
   }
 #endif
 
-  length = receivePulseTrain(pulses);
+  tx_poll();
+  // echoes are parsed before their transmissions are accounted
+  const bool verifying = echo_verifying();
+  processReceived(verifying);
+  if (verifying) {
+    finish_echo(0);
+  }
+  int handle;
+  while ((handle = tx_completed()) != 0) {
+    if (_transmitCallback != nullptr) {
+      (_transmitCallback)(handle);
+    }
+  }
+}
+
+void ESPiLight::processReceived(bool all) {
+  int length = 0;
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
 
-  if (length > 0) {
+  while ((length = receivePulseTrain(pulses)) > 0) {
 /*
     Debug("RAW (");
     Debug(length);
@@ -332,19 +760,40 @@ void ESPiLight::loop() {
     DebugLn();
 */
     parsePulseTrain(pulses, (uint8_t)length);
+    if (!all) {
+      break;
+    }
+  }
+}
+
+ESPiLight::ESPiLight(int8_t outputPin) : ESPiLight(TransmitOutput_t()) {
+  if (outputPin >= 0) {
+    const uint8_t pin = (uint8_t)outputPin;
+    tx_output_register(&_output, &pin, 1);
+  }
+}
+
+ESPiLight::ESPiLight(const uint8_t *outputPins, size_t count)
+    : ESPiLight(TransmitOutput_t()) {
+  if (count > 0) {
+    tx_output_register(&_output, outputPins, count);
   }
 }
 
-ESPiLight::ESPiLight(int8_t outputPin) {
-  _outputPin = outputPin;
+ESPiLight::ESPiLight(const TransmitOutput_t &output) {
+  _output = output;
   _callback = nullptr;
   _rawCallback = nullptr;
+  _messageCallback = nullptr;
+  _messageBuffer = nullptr;
+  _messageSize = 0;
+  _messageOutput = nullptr;
   _echoEnabled = false;
-
-  if (_outputPin >= 0) {
-    pinMode((uint8_t)_outputPin, OUTPUT);
-    digitalWrite((uint8_t)_outputPin, LOW);
-  }
+  _adaptiveTiming = false;
+  _bestMatch = false;
+  _confidence = 0;
+  _echoVerification = 0;
+  _transmitCallback = nullptr;
 
   get_protocols();
 }
@@ -357,54 +806,200 @@ void ESPiLight::setPulseTrainCallBack(PulseTrainCallBack rawCallback) {
   _rawCallback = rawCallback;
 }
 
-void ESPiLight::sendPulseTrain(const uint16_t *pulses, size_t length,
+void ESPiLight::setMessageCallback(MessageCallBack callback, char *buffer,
+                                   size_t size) {
+  _messageCallback = callback;
+  _messageBuffer = buffer;
+  _messageSize = size;
+  _messageOutput = nullptr;
+}
+
+void ESPiLight::setMessageCallback(MessageCallBack callback, Print &output) {
+  _messageCallback = callback;
+  _messageBuffer = nullptr;
+  _messageSize = 0;
+  _messageOutput = &output;
+}
+
+void ICACHE_RAM_ATTR ESPiLight::transmitState(bool active) {
+  if (active) {
+    _receiverState = _enabledReceiver;
+    _enabledReceiver = (_echoTransmit && _receiverState);
+    if (_receiverState && !_enabledReceiver) {
+      _deafSince = tx_micros();
+    }
+  } else {
+    if (_receiverState && !_enabledReceiver) {
+      _deafTime = _deafTime + (uint32_t)(tx_micros() - _deafSince);
+      // a frame captured before is incomplete
+      _nrpulses = 0;
+    }
+    _enabledReceiver = _receiverState;
+  }
+}
+
+bool ICACHE_RAM_ATTR ESPiLight::receiving(unsigned long now) {
+  return _enabledReceiver && !_echoTransmit &&
+         _nrpulses >= RECEIVER_BUSY_PULSES && now - _lastPulse < mingaplen;
+}
+
+int ESPiLight::sendPulseTrain(const uint16_t *pulses, size_t length,
+                              size_t repeats) {
+  CompactPulseTrain_t frame;
+  const int result = compressPulseTrain(&frame, pulses, length);
+  if (result < 0) {
+    return result;
+  }
+  sendPulseTrain(&frame, repeats);
+  return result;
+}
+
+void ESPiLight::sendPulseTrain(const CompactPulseTrain_t *frame,
                                size_t repeats) {
-  if (_outputPin >= 0) {
-    bool receiverState = _enabledReceiver;
-    _enabledReceiver = (_echoEnabled && receiverState);
-    for (unsigned int r = 0; r < repeats; r++) {
-      for (unsigned int i = 0; i < length; i += 2) {
-        digitalWrite((uint8_t)_outputPin, HIGH);
-        delayMicroseconds(pulses[i]);
-        digitalWrite((uint8_t)_outputPin, LOW);
-        if (i + 1 < length) {
-          delayMicroseconds(pulses[i + 1]);
-        }
-      }
+  transmit(nullptr, frame, repeats, 0, 0, false);
+}
+
+int ESPiLight::sendPulseTrainAsync(const uint16_t *pulses, size_t length,
+                                   size_t repeats, uint8_t priority,
+                                   uint16_t gap) {
+  CompactPulseTrain_t frame;
+  const int result = compressPulseTrain(&frame, pulses, length);
+  if (result < 0) {
+    return result;
+  }
+  return enqueuePulseTrain(&frame, repeats, priority, gap, true);
+}
+
+int ESPiLight::sendPulseTrainAsync(const CompactPulseTrain_t *frame,
+                                   size_t repeats, uint8_t priority,
+                                   uint16_t gap) {
+  return enqueuePulseTrain(frame, repeats, priority, gap, true);
+}
+
+int ESPiLight::transmit(protocol_t *protocol, const CompactPulseTrain_t *frame,
+                        size_t repeats, uint8_t priority, uint16_t gap,
+                        bool async) {
+  int handle;
+  while ((handle = enqueuePulseTrain(frame, repeats, priority, gap, async)) ==
+             ERROR_TRANSMITTER_BUSY &&
+         !async) {
+    tx_poll();
+    yield();
+  }
+  const bool verify = (handle > 0 && protocol != nullptr && _echoEnabled &&
+                       _echoVerification > 0);
+  if (verify) {
+    start_echo(handle, protocol, frame, _echoVerification);
+  }
+  if (async) {
+    return handle;
+  }
+  while (handle > 0 && tx_pending(handle)) {
+    tx_poll();
+    if (verify) {
+      processReceived(true);
     }
-    digitalWrite((uint8_t)_outputPin, LOW);
-    _enabledReceiver = receiverState;
+    yield();
+  }
+  if (verify) {
+    processReceived(true);
+    finish_echo(handle);
   }
+  return handle;
+}
+
+int ESPiLight::enqueuePulseTrain(const CompactPulseTrain_t *frame,
+                                 size_t repeats, uint8_t priority,
+                                 uint16_t gap, bool notify) {
+  if (_output.write == nullptr) {
+    DebugLn("No output pin set, cannot send");
+    return ERROR_NO_OUTPUT_PIN;
+  }
+  tx_set_state_callback(transmitState);
+  _echoTransmit = _echoEnabled;
+  const int handle =
+      tx_enqueue(&_output, frame, repeats, priority, gap, notify);
+  return handle > 0 ? handle : ERROR_TRANSMITTER_BUSY;
 }
 
 int ESPiLight::send(const String &protocol, const String &json,
                     size_t repeats) {
-  if (_outputPin < 0) {
+  if (_output.write == nullptr) {
     DebugLn("No output pin set, cannot send");
     return ERROR_NO_OUTPUT_PIN;
   }
-  int length = 0;
-  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  int error = 0;
+  const tx_cache_t *entry = cache_pulse_train(protocol, json, false, &error);
+  if (entry == nullptr) {
+    return error;
+  }
+  transmit(entry->protocol, &entry->frame,
+           repeats > 0 ? repeats : entry->protocol->txrpt, 0, 0, false);
+  return entry->frame.length;
+}
 
-  protocol_t *protocol_listener = find_protocol(protocol.c_str());
-  length = create_pulse_train(pulses, protocol_listener, json);
-  if (length > 0) {
-    /*
-    DebugLn();
-    Debug("send: ");
-    Debug(length);
-    Debug(" pulses (");
-    Debug(protocol);
-    Debug(", ");
-    Debug(content);
-    DebugLn(")");
-    */
-    if (repeats == 0) {
-      repeats = protocol_listener->txrpt;
-    }
-    sendPulseTrain(pulses, (unsigned)length, repeats);
+int ESPiLight::sendAsync(const String &protocol, const String &json,
+                         size_t repeats, uint8_t priority, uint16_t gap) {
+  if (_output.write == nullptr) {
+    DebugLn("No output pin set, cannot send");
+    return ERROR_NO_OUTPUT_PIN;
   }
-  return length;
+  int error = 0;
+  const tx_cache_t *entry = cache_pulse_train(protocol, json, false, &error);
+  if (entry == nullptr) {
+    return error;
+  }
+  return transmit(entry->protocol, &entry->frame,
+                  repeats > 0 ? repeats : entry->protocol->txrpt, priority,
+                  gap, true);
+}
+
+int ESPiLight::registerCommand(const String &protocol, const String &json) {
+  int error = 0;
+  const tx_cache_t *entry = cache_pulse_train(protocol, json, true, &error);
+  if (entry == nullptr) {
+    return error;
+  }
+  return (int)(entry - tx_cache) + 1;
+}
+
+void ESPiLight::releaseCommand(int command) {
+  if (command > 0 && command <= TX_CACHE_SIZE) {
+    tx_cache[command - 1].pinned = false;
+  }
+}
+
+int ESPiLight::sendCommand(int command, size_t repeats) {
+  const tx_cache_t *entry = find_command(command);
+  if (entry == nullptr) {
+    return ERROR_UNKNOWN_COMMAND;
+  }
+  if (_output.write == nullptr) {
+    DebugLn("No output pin set, cannot send");
+    return ERROR_NO_OUTPUT_PIN;
+  }
+  transmit(entry->protocol, &entry->frame,
+           repeats > 0 ? repeats : entry->protocol->txrpt, 0, 0, false);
+  return entry->frame.length;
+}
+
+int ESPiLight::sendCommandAsync(int command, size_t repeats, uint8_t priority,
+                                uint16_t gap) {
+  const tx_cache_t *entry = find_command(command);
+  if (entry == nullptr) {
+    return ERROR_UNKNOWN_COMMAND;
+  }
+  return transmit(entry->protocol, &entry->frame,
+                  repeats > 0 ? repeats : entry->protocol->txrpt, priority,
+                  gap, true);
+}
+
+bool ESPiLight::transmitting(int handle) const { return tx_pending(handle); }
+
+void ESPiLight::abortTransmit(int handle) { tx_abort(handle); }
+
+void ESPiLight::setTransmitCallback(TransmitCallBack callback) {
+  _transmitCallback = callback;
 }
 
 int ESPiLight::createPulseTrain(uint16_t *pulses, const String &protocol_id,
@@ -413,18 +1008,211 @@ int ESPiLight::createPulseTrain(uint16_t *pulses, const String &protocol_id,
   return create_pulse_train(pulses, protocol, content);
 }
 
+protocol_t *ESPiLight::findProtocol(const String &name) {
+  return find_protocol(name.c_str());
+}
+
+static int has_arg(const char *name, void *arg) {
+  return json_find_member(static_cast<JsonNode *>(arg), name) != nullptr;
+}
+
+int ESPiLight::createPulseTrain(uint16_t *pulses, protocol_t *protocol,
+                                const PilightArg_t *args, size_t nargs,
+                                const char **missing, size_t maxMissing) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wtype-limits"
+  if ((protocol == nullptr) || (protocol->createCode == nullptr) ||
+      (protocol->maxrawlen > MAXPULSESTREAMLENGTH)) {
+#pragma GCC diagnostic pop
+    return ERROR_UNAVAILABLE_PROTOCOL;
+  }
+  if (nargs > MAX_PILIGHT_ARGS) {
+    return ERROR_INVALID_PILIGHT_MSG;
+  }
+
+  // build the json object on the stack, createCode() only reads it
+  JsonNode nodes[MAX_PILIGHT_ARGS + 1];
+  JsonNode *code = &nodes[0];
+  memset(nodes, 0, sizeof(nodes[0]) * (nargs + 1));
+  code->tag = JSON_OBJECT;
+  for (size_t i = 0; i < nargs; i++) {
+    JsonNode *node = &nodes[i + 1];
+    node->parent = code;
+    node->key = const_cast<char *>(args[i].key);
+    if (args[i].string != nullptr) {
+      node->tag = JSON_STRING;
+      node->string_ = const_cast<char *>(args[i].string);
+    } else {
+      node->tag = JSON_NUMBER;
+      node->number_ = args[i].number;
+    }
+    node->prev = code->children.tail;
+    if (code->children.tail != nullptr) {
+      code->children.tail->next = node;
+    } else {
+      code->children.head = node;
+    }
+    code->children.tail = node;
+  }
+
+  protocol->rawlen = 0;
+  protocol->raw = pulses;
+  log_mute++;
+  const int return_value = protocol->createCode(code);
+  log_mute--;
+  // delete message created by createCode()
+  json_delete(protocol->message);
+  protocol->message = nullptr;
+
+  if (return_value != EXIT_SUCCESS) {
+    if (missing != nullptr && maxMissing > 0) {
+      const int count = protocol_missing_args(protocol, has_arg, code, missing,
+                                              (int)maxMissing);
+      if ((size_t)count < maxMissing) {
+        missing[count] = nullptr;
+      }
+    }
+    return ERROR_INVALID_PILIGHT_MSG;
+  }
+  return protocol->rawlen;
+}
+
+/**
+ * Estimate the base pulse length of a frame as the median of its short data
+ * pulses, those up to the middle between the shortest and the longest one.
+ * The footer is not used. work must hold length pulses. Returns 0 for
+ * frames without data pulses.
+ */
+static uint32_t estimate_base_pulse(const uint16_t *pulses, uint8_t length,
+                                    uint16_t *work) {
+  uint16_t shortest = std::numeric_limits<uint16_t>::max();
+  uint16_t longest = 0;
+  uint8_t count = 0;
+
+  if (length < 2) {
+    return 0;
+  }
+  for (uint8_t i = 0; i + 1 < length; i++) {
+    shortest = std::min(shortest, pulses[i]);
+    longest = std::max(longest, pulses[i]);
+  }
+  const uint32_t middle = ((uint32_t)shortest + longest) / 2;
+  for (uint8_t i = 0; i + 1 < length; i++) {
+    if (pulses[i] <= middle) {
+      work[count++] = pulses[i];
+    }
+  }
+  std::nth_element(work, work + count / 2, work + count);
+  return work[count / 2];
+}
+
+/**
+ * Return the Q12 factor, which moves value to the middle of [min, max], if it
+ * is up to ADAPTIVE_TIMING_TOLERANCE percent outside. Otherwise, the factor
+ * is 1.
+ */
+static uint32_t adaptive_factor(uint32_t value, uint32_t min, uint32_t max) {
+  if (value == 0 || min == 0 || (value >= min && value <= max) ||
+      value * 100 < min * (100 - ADAPTIVE_TIMING_TOLERANCE) ||
+      value * 100 > max * (100 + ADAPTIVE_TIMING_TOLERANCE)) {
+    return 1 << 12;
+  }
+  return (((min + max) / 2) << 12) / value;
+}
+
+/**
+ * Rescale the pulse train to the nominal timing of the protocol. The data
+ * pulses are scaled by the base pulse length of the frame (see
+ * estimate_base_pulse()) and the footer by itself, each only when it is
+ * up to ADAPTIVE_TIMING_TOLERANCE percent outside the range of the
+ * protocol. Frames which fit are returned unchanged.
+ * scale is the Q12 factor of the data pulses currently stored in scaled.
+ */
+static uint16_t *adapt_pulse_train(const protocol_t *protocol,
+                                   uint16_t *pulses, uint8_t length,
+                                   uint32_t base, uint16_t *scaled,
+                                   uint32_t *scale) {
+  const uint32_t mingap = std::min(protocol->mingaplen, protocol->maxgaplen);
+  const uint32_t maxgap = std::max(protocol->mingaplen, protocol->maxgaplen);
+  const uint32_t data =
+      adaptive_factor(base, mingap / PULSE_DIV, maxgap / PULSE_DIV);
+  const uint32_t footer = adaptive_factor(pulses[length - 1], mingap, maxgap);
+
+  if (data == 1 << 12 && footer == 1 << 12) {
+    return pulses;
+  }
+  if (data != *scale) {
+    for (uint8_t i = 0; i + 1 < length; i++) {
+      scaled[i] = (uint16_t)std::min<uint32_t>(
+          ((uint32_t)pulses[i] * data) >> 12,
+          std::numeric_limits<uint16_t>::max());
+    }
+    *scale = data;
+  }
+  scaled[length - 1] = (uint16_t)std::min<uint32_t>(
+      ((uint32_t)pulses[length - 1] * footer) >> 12,
+      std::numeric_limits<uint16_t>::max());
+  return scaled;
+}
+
+/**
+ * Score a decoded frame from 0 to 100. The timing part measures how well
+ * the pulses fit onto the grid of the base pulse length of the protocol
+ * (derived from its footer range, footer = PULSE_DIV * base pulse) and how
+ * close the received footer is to the nominal one. Frames of protocols
+ * which verify a checksum get the remaining quarter.
+ */
+static uint8_t frame_confidence(const protocol_t *protocol) {
+  const uint32_t nominal = (protocol->mingaplen + protocol->maxgaplen) / 2;
+  const uint32_t base = nominal / PULSE_DIV;
+  uint32_t deviation = 0;
+
+  if (base == 0 || protocol->rawlen == 0) {
+    return protocol->checksum ? 25 : 0;
+  }
+  for (uint8_t i = 0; i + 1 < protocol->rawlen; i++) {
+    const uint32_t pulse = protocol->raw[i];
+    const uint32_t multiple = std::max<uint32_t>((pulse + base / 2) / base, 1);
+    const uint32_t diff = pulse > multiple * base ? pulse - multiple * base
+                                                  : multiple * base - pulse;
+    deviation += std::min<uint32_t>(diff * 100 / base, 50);
+  }
+  const uint32_t footer = protocol->raw[protocol->rawlen - 1];
+  const uint32_t diff = footer > nominal ? footer - nominal : nominal - footer;
+  deviation += std::min<uint32_t>(diff * 100 / nominal, 50);
+
+  const uint32_t timing = 100 - 2 * deviation / protocol->rawlen;
+  return (uint8_t)(timing * 3 / 4 + (protocol->checksum ? 25 : 0));
+}
+
 size_t ESPiLight::parsePulseTrain(uint16_t *pulses, uint8_t length) {
   size_t matches = 0;
   protocol_t *protocol = nullptr;
   protocols_t *pnode = get_used_protocols();
+  uint16_t scaled[MAXPULSESTREAMLENGTH];
+  uint32_t scale = 0;
+  protocol_t *best = nullptr;
+  uint8_t bestConfidence = 0;
+  const message_sink_t sink = {&_callback, &_messageCallback, _messageBuffer,
+                               _messageSize, _messageOutput};
+  const bool callback = _callback != nullptr || _messageCallback != nullptr;
+  // echoes are verified, even if no message is delivered
+  const bool echo = echo_verifying();
+  // scaled is only the work area of the estimate until it is filled
+  const uint32_t base =
+      _adaptiveTiming ? estimate_base_pulse(pulses, length, scaled) : 0;
 
   // DebugLn("piLightParsePulseTrain start");
-  while ((pnode != nullptr) && (_callback != nullptr)) {
+  while ((pnode != nullptr) && (callback || echo)) {
     protocol = pnode->listener;
 
     if (protocol->parseCode != nullptr && protocol->validate != nullptr) {
       protocol->raw = pulses;
       protocol->rawlen = length;
+      if (_adaptiveTiming && length > 0) {
+        protocol->raw =
+            adapt_pulse_train(protocol, pulses, length, base, scaled, &scale);
+      }
 
       if (protocol->validate() == 0) {
         Debug("pulses: ");
@@ -445,21 +1233,48 @@ size_t ESPiLight::parsePulseTrain(uint16_t *pulses, uint8_t length) {
           protocol->repeats = 0;
         }
 
-        protocol->message = nullptr;
-        protocol->parseCode();
+        // the message is released at once by json_delete()
+        parse_code(protocol);
         if (protocol->message != nullptr) {
-          matches++;
           protocol->repeats++;
-
-          fire_callback(protocol, _callback);
-
-          json_delete(protocol->message);
-          protocol->message = nullptr;
+          verify_echo(protocol);
+          const uint8_t confidence =
+              frame_confidence(protocol);
+
+          if (!callback) {
+            json_delete(protocol->message);
+            protocol->message = nullptr;
+          } else if (!_bestMatch) {
+            matches++;
+            _confidence = confidence;
+            fire_callback(&sink, protocol->id, protocol->message, FIRST,
+                          protocol->repeats & 0x7F);
+            json_delete(protocol->message);
+            protocol->message = nullptr;
+          } else if (best == nullptr || confidence > bestConfidence) {
+            if (best != nullptr) {
+              json_delete(best->message);
+              best->message = nullptr;
+            }
+            best = protocol;
+            bestConfidence = confidence;
+          } else {
+            json_delete(protocol->message);
+            protocol->message = nullptr;
+          }
         }
       }
     }
     pnode = pnode->next;
   }
+  if (best != nullptr) {
+    matches++;
+    _confidence = bestConfidence;
+    fire_callback(&sink, best->id, best->message, FIRST,
+                  best->repeats & 0x7F);
+    json_delete(best->message);
+    best->message = nullptr;
+  }
   if (_rawCallback != nullptr) {
     (_rawCallback)(pulses, length);
   }
@@ -469,26 +1284,51 @@ size_t ESPiLight::parsePulseTrain(uint16_t *pulses, uint8_t length) {
   return matches;
 }
 
-static void fire_callback(protocol_t *protocol, ESPiLightCallBack callback) {
-  PilightRepeatStatus_t status = FIRST;
-  char *content = json_encode(protocol->message);
+static String device_id(JsonNode *message) {
   String deviceId = "";
   double itmp;
   char *stmp;
 
-
-  if((protocol->old_content != nullptr)) {
-    json_free(protocol->old_content);
-  }
-  protocol->old_content = content;
-
-  if (json_find_number(protocol->message, "id", &itmp) == 0) {
+  if (json_find_number(message, "id", &itmp) == 0) {
     deviceId = String((int)round(itmp));
-  } else if (json_find_string(protocol->message, "id", &stmp) == 0) {
+  } else if (json_find_string(message, "id", &stmp) == 0) {
     deviceId = String(stmp);
   };
-  (callback)(String(protocol->id), String(protocol->old_content), status,
-             protocol->repeats & 0x7F, deviceId);
+  return deviceId;
+}
+
+static void print_json(void *arg, const char *bytes, size_t count) {
+  static_cast<Print *>(arg)->write(reinterpret_cast<const uint8_t *>(bytes),
+                                   count);
+}
+
+static void fire_callback(const message_sink_t *sink, const char *protocol,
+                          JsonNode *message, int status, size_t repeats) {
+  if (*sink->messageCallback != nullptr) {
+    size_t length = 0;
+    if (sink->output != nullptr) {
+      length = json_encode_writer(message, print_json, sink->output);
+      (*sink->messageCallback)(protocol, nullptr, length, status, repeats);
+    } else {
+      length = json_encode_buffer(message, sink->buffer, sink->size);
+      (*sink->messageCallback)(protocol, sink->buffer, length, status,
+                               repeats);
+    }
+  }
+  if (*sink->callback != nullptr) {
+    char buffer[MESSAGE_BUFFER_SIZE];
+    if (json_encode_buffer(message, buffer, sizeof(buffer)) < sizeof(buffer)) {
+      (*sink->callback)(String(protocol), String(buffer), status, repeats,
+                        device_id(message));
+    } else {
+      char *content = json_encode(message);
+      if (content != nullptr) {
+        (*sink->callback)(String(protocol), String(content), status, repeats,
+                          device_id(message));
+        json_free(content);
+      }
+    }
+  }
 }
 
 String ESPiLight::pulseTrainToString(const uint16_t *codes, size_t length) {
@@ -583,6 +1423,24 @@ int ESPiLight::stringToPulseTrain(const String &data, uint16_t *codes,
   return length;
 }
 
+int ESPiLight::compressPulseTrain(CompactPulseTrain_t *frame,
+                                  const uint16_t *pulses, size_t length,
+                                  uint32_t *deviation) {
+  const uint32_t error = tx_frame_encode(frame, pulses, length);
+  if (deviation != nullptr) {
+    *deviation = error;
+  }
+  if (length > MAXPULSESTREAMLENGTH || error != 0) {
+    return ERROR_INEXACT_PULSETRAIN;
+  }
+  return (int)length;
+}
+
+size_t ESPiLight::expandPulseTrain(const CompactPulseTrain_t *frame,
+                                   uint16_t *pulses) {
+  return tx_frame_decode(frame, pulses);
+}
+
 int ESPiLight::stringToRepeats(const String &data) {
   // parsing (optional) repeats
   int srepeat = data.indexOf('r') + 2;
@@ -603,11 +1461,11 @@ int ESPiLight::stringToRepeats(const String &data) {
 }
 
 void ESPiLight::limitProtocols(const String &protos) {
-  if (!json_validate(protos.c_str())) {
+  JsonNode *message = json_parse(protos.c_str(), nullptr);
+  if (message == nullptr) {
     DebugLn("Protocol limit argument is not a valid json message!");
     return;
   }
-  JsonNode *message = json_decode(protos.c_str());
 
   if (message->tag != JSON_ARRAY) {
     DebugLn("Protocol limit argument is not a json array!");
@@ -662,6 +1520,89 @@ void ESPiLight::limitProtocols(const String &protos) {
   calc_lengths();
 }
 
+static bool load_device(JsonNode *device) {
+  JsonNode *jprotocols = json_find_member(device, "protocol");
+  if (jprotocols == nullptr) {
+    DebugLn("Device has no protocol");
+    return false;
+  }
+
+  JsonNode *jprotocol = jprotocols;
+  if (jprotocols->tag == JSON_ARRAY) {
+    jprotocol = json_first_child(jprotocols);
+  }
+
+  bool loaded = false;
+  while (jprotocol != nullptr) {
+    if (jprotocol->tag == JSON_STRING) {
+      protocol_t *protocol = find_protocol(jprotocol->string_);
+      if (protocol == nullptr) {
+        Debug("Protocol not found: ");
+        DebugLn(jprotocol->string_);
+      } else if (protocol->checkValues == nullptr ||
+                 protocol->checkValues(device) == 0) {
+        loaded = true;
+      } else {
+        Debug("Invalid device settings for protocol ");
+        DebugLn(protocol->id);
+        return false;
+      }
+    }
+    if (jprotocols->tag != JSON_ARRAY) {
+      break;
+    }
+    jprotocol = jprotocol->next;
+  }
+  return loaded;
+}
+
+int ESPiLight::loadDevices(const String &devices) {
+  JsonError error;
+  JsonNode *message = json_parse(devices.c_str(), &error);
+  if (message == nullptr) {
+    if (error.code == JSON_ERROR_MEMORY) {
+      return ERROR_OUT_OF_MEMORY;
+    }
+    DebugLn("Devices argument is not a valid json message!");
+    return ERROR_INVALID_JSON;
+  }
+
+  if (message->tag != JSON_OBJECT && message->tag != JSON_ARRAY) {
+    DebugLn("Devices argument is neither a json object nor an array!");
+    json_delete(message);
+    return ERROR_INVALID_JSON;
+  }
+
+  clearDevices();
+
+  int device_count = 0;
+  JsonNode *device = nullptr;
+  json_foreach(device, message) {
+    if (device->tag != JSON_OBJECT) {
+      DebugLn("Device is not an object");
+      continue;
+    }
+    if (load_device(device)) {
+      device_count++;
+    }
+  }
+
+  json_delete(message);
+  return device_count;
+}
+
+void ESPiLight::clearDevices() {
+  // gc() of the pilight protocols only frees the device settings that were
+  // collected by checkValues().
+  protocols_t *pnode = get_protocols();
+  while (pnode != nullptr) {
+    if (pnode->listener->gc != nullptr) {
+      pnode->listener->gc();
+    }
+    pnode = pnode->next;
+  }
+}
+
 static String protocols_to_array(protocols_t *pnode) {
   protocols_t *tmp = pnode;
   size_t needed_len = 2;  // []
@@ -702,4 +1643,75 @@ String ESPiLight::enabledProtocols() {
 
 void ESPiLight::setEchoEnabled(bool enabled) { _echoEnabled = enabled; }
 
+void ESPiLight::setEchoVerification(uint8_t echoes) {
+  _echoVerification = echoes;
+}
+
+EchoStats_t ESPiLight::echoStats(const String &protocol) {
+  const echo_stats_t *entry = find_echo_stats(protocol.c_str(), false);
+  if (entry == nullptr) {
+    return EchoStats_t();
+  }
+  return entry->stats;
+}
+
+void ESPiLight::clearEchoStats() {
+  for (uint8_t i = 0; i < ECHO_STATS_SIZE; i++) {
+    echo_stats[i].protocol = nullptr;
+    echo_stats[i].stats = EchoStats_t();
+  }
+}
+
+void ESPiLight::setAdaptiveTimingEnabled(bool enabled) {
+  _adaptiveTiming = enabled;
+}
+
+void ESPiLight::setBestMatchEnabled(bool enabled) { _bestMatch = enabled; }
+
+uint8_t ESPiLight::confidence() const { return _confidence; }
+
+void ESPiLight::setDutyCycle(uint16_t permille, uint32_t windowMs) {
+  tx_set_duty_cycle(permille, windowMs);
+}
+
+uint32_t ESPiLight::airtime() { return tx_airtime(); }
+
+void ESPiLight::setListenBeforeTransmit(uint16_t listenUs,
+                                        uint32_t maxDeferUs) {
+  tx_set_listen(receiving, listenUs, maxDeferUs);
+}
+
+uint32_t ESPiLight::deafTime(bool reset) {
+  noInterrupts();
+  const uint32_t deaf = _deafTime;
+  if (reset) {
+    _deafTime = 0;
+  }
+  interrupts();
+  return deaf;
+}
+
+void ESPiLight::setPreciseTimingEnabled(bool enabled) {
+  tx_set_precise(enabled);
+}
+
+TransmitTiming_t ESPiLight::transmitTiming(bool reset) {
+  return tx_timing(reset);
+}
+
+static void loopback_edge(const sim_edge_t *edge) {
+  ESPiLight::receiveEdge(edge->time);
+}
+
+void ESPiLight::beginSimulation(SimulatedEdge_t *edges, size_t size,
+                                Print *output, bool loopback) {
+  sim_begin(edges, size, output, loopback ? loopback_edge : nullptr);
+}
+
+void ESPiLight::endSimulation() { sim_end(); }
+
+size_t ESPiLight::simulatedEdges() { return sim_recorded(); }
+
+uint32_t ESPiLight::simulationTime() { return sim_time(); }
+
 void ESPiLight::setErrorOutput(Print &output) { set_aprintf_output(&output); }
@@ -26,12 +26,45 @@
 #define RECEIVER_BUFFER_SIZE 16
 #endif
 
+// Number of captured pulses from which a frame is regarded in progress
+#ifndef RECEIVER_BUSY_PULSES
+#define RECEIVER_BUSY_PULSES 8
+#endif
+
 #ifndef MAXPULSESTREAMLENGTH
 #define MAXPULSESTREAMLENGTH 255
 #endif
 
 #define MAX_PULSE_TYPES 16
 
+#include "tools/simulator.h"
+#include "tools/transmitter.h"
+
+// Maximum number of arguments of a typed Pilight message
+#ifndef MAX_PILIGHT_ARGS
+#define MAX_PILIGHT_ARGS 8
+#endif
+
+// Number of cached pulse trains of send(), sendAsync() and registerCommand()
+#ifndef TX_CACHE_SIZE
+#define TX_CACHE_SIZE 8
+#endif
+
+// Number of protocols with echo statistics
+#ifndef ECHO_STATS_SIZE
+#define ECHO_STATS_SIZE 8
+#endif
+
+// Size of the stack buffer a message is encoded into for the callback, longer
+// messages are encoded on the heap
+#ifndef MESSAGE_BUFFER_SIZE
+#define MESSAGE_BUFFER_SIZE 128
+#endif
+
+#ifndef ADAPTIVE_TIMING_TOLERANCE
+#define ADAPTIVE_TIMING_TOLERANCE 25  // percent
+#endif
+
 enum PilightRepeatStatus_t { FIRST, INVALID, VALID, KNOWN };
 
 typedef struct PulseTrain_t {
@@ -40,11 +73,60 @@ typedef struct PulseTrain_t {
   bool ok;
 } PulseTrain_t;
 
+/**
+ * Compact pulse train (pulse type table and 4 bit type indices, see
+ * tools/transmitter.h), created by compressPulseTrain(). It can be stored
+ * and transmitted without expanding it first.
+ */
+typedef tx_frame_t CompactPulseTrain_t;
+
+/**
+ * Timing error of transmitted frames, see tx_timing_t.
+ */
+typedef tx_timing_t TransmitTiming_t;
+
+/**
+ * Output driver of a transmitter, see tx_output_t.
+ */
+typedef tx_output_t TransmitOutput_t;
+
+/**
+ * Output write of the simulated transmitter, see beginSimulation().
+ */
+typedef sim_edge_t SimulatedEdge_t;
+
+/**
+ * Echo statistics of a protocol, see setEchoVerification().
+ */
+typedef struct EchoStats_t {
+  uint32_t transmissions;  // verified transmissions
+  uint32_t confirmed;      // transmissions with a verified echo
+  uint32_t echoes;         // verified echoes
+  uint32_t latency;        // mean time to the first verified echo in us
+  uint32_t maxLatency;     // in us
+} EchoStats_t;
+
 typedef std::function<void(const String &protocol, const String &message,
                            int status, size_t repeats, const String &deviceID)>
     ESPiLightCallBack;
 typedef std::function<void(const uint16_t *pulses, size_t length)>
     PulseTrainCallBack;
+typedef std::function<void(int handle)> TransmitCallBack;
+typedef std::function<void(const char *protocol, const char *message,
+                           size_t length, int status, size_t repeats)>
+    MessageCallBack;
+
+/**
+ * Argument of a typed Pilight message, e.g. {"id", 1234}, {"on", 1} or
+ * {"label", 0, "text"}. Flags, like "on", take any number.
+ */
+typedef struct PilightArg_t {
+  const char *key;
+  double number;
+  const char *string;  // if not nullptr, the argument is a string
+} PilightArg_t;
+
+struct protocol_t;
 
 class ESPiLight {
  public:
@@ -54,19 +136,109 @@ class ESPiLight {
   ESPiLight(int8_t outputPin);
 
   /**
-   * Transmit pulse train
+   * Constructor for a transmitter on count pins (at most TX_OUTPUT_PINS),
+   * which are driven with the same signal, e.g. antennas in several rooms.
+   */
+  ESPiLight(const uint8_t *outputPins, size_t count);
+
+  /**
+   * Constructor for a transmitter with its own output driver. Instances
+   * with different outputs share the queue and transmit concurrently.
    */
-  void sendPulseTrain(const uint16_t *pulses, size_t length,
-                      size_t repeats = 10);
+  ESPiLight(const TransmitOutput_t &output);
+
+  /**
+   * Transmit pulse train exactly. Returns length or ERROR_INEXACT_PULSETRAIN,
+   * if it has more than MAXPULSESTREAMLENGTH pulses or more than
+   * TX_PULSE_TYPES different durations, see compressPulseTrain(). Nothing is
+   * sent then. Pulse trains with jitter can be packed by compressPulseTrain()
+   * and sent as compact pulse train.
+   */
+  int sendPulseTrain(const uint16_t *pulses, size_t length,
+                     size_t repeats = 10);
+
+  /**
+   * Transmit compact pulse train
+   */
+  void sendPulseTrain(const CompactPulseTrain_t *frame, size_t repeats = 10);
 
   /**
    * Transmit Pilight json message
    * repeats of 0 means repeats as defined in protocol.
+   * The pulse trains of the last TX_CACHE_SIZE messages are cached, repeated
+   * messages (whitespace is ignored) are not encoded again.
    */
   int send(const String &protocol, const String &json, size_t repeats = 0);
 
+  /**
+   * Queue a pulse train and return immediately. The pulses are sent by a
+   * timer interrupt (ESP8266 and ESP32, blocking elsewhere), which takes
+   * timer1 on ESP8266 and hardware timer 0 on ESP32 from the first
+   * asynchronous transmission on. Sketches using that timer (e.g. by
+   * analogWrite(), tone() or Servo on ESP8266) must only use the blocking
+   * functions, which use no timer. Queued entries with higher priority are
+   * sent first, repeats of entries with equal priority are interleaved in
+   * bursts of TX_QUEUE_BURST. gap is an additional pause in microseconds
+   * after every repeat.
+   * Returns a handle (> 0) for transmitting() and the transmit callback,
+   * ERROR_NO_OUTPUT_PIN, ERROR_TRANSMITTER_BUSY (queue full) or
+   * ERROR_INEXACT_PULSETRAIN (see sendPulseTrain()).
+   */
+  int sendPulseTrainAsync(const uint16_t *pulses, size_t length,
+                          size_t repeats = 10, uint8_t priority = 0,
+                          uint16_t gap = 0);
+
+  int sendPulseTrainAsync(const CompactPulseTrain_t *frame,
+                          size_t repeats = 10, uint8_t priority = 0,
+                          uint16_t gap = 0);
+
+  /**
+   * Queue a Pilight json message, like sendPulseTrainAsync().
+   * Returns the handle or an error code of send().
+   */
+  int sendAsync(const String &protocol, const String &json,
+                size_t repeats = 0, uint8_t priority = 0, uint16_t gap = 0);
+
+  /**
+   * Create the pulse train of a Pilight json message once and keep it,
+   * until releaseCommand() is called. Returns a command (> 0) for
+   * sendCommand() and sendCommandAsync() or an error code of send() or
+   * ERROR_CACHE_FULL, if it would pin the last entry of the cache, which is
+   * not pinned.
+   */
+  static int registerCommand(const String &protocol, const String &json);
+  static void releaseCommand(int command);
+
+  /**
+   * Transmit a registered command, like send() and sendAsync().
+   * Returns ERROR_UNKNOWN_COMMAND, if command is not registered.
+   */
+  int sendCommand(int command, size_t repeats = 0);
+  int sendCommandAsync(int command, size_t repeats = 0, uint8_t priority = 0,
+                       uint16_t gap = 0);
+
+  /**
+   * Returns true while the transmission of handle (or any transmission, if
+   * handle is 0) is not yet completed.
+   */
+  bool transmitting(int handle = 0) const;
+
+  /**
+   * Drop the queued transmission of handle (or all, if handle is 0). A
+   * repeat which is on air is completed. The transmit callback is called
+   * for dropped transmissions, too.
+   */
+  void abortTransmit(int handle = 0);
+
+  /**
+   * Set a callback, called from loop() with the handle of every completed
+   * asynchronous transmission.
+   */
+  void setTransmitCallback(TransmitCallBack callback);
+
   /**
    * Parse pulse train and fire callback
+   * Returns the number of messages passed to the callback.
    */
   size_t parsePulseTrain(uint16_t *pulses, uint8_t length);
 
@@ -78,18 +250,72 @@ class ESPiLight {
   void setCallback(ESPiLightCallBack callback);
   void setPulseTrainCallBack(PulseTrainCallBack rawCallback);
 
+  /**
+   * Like setCallback(), but every message is encoded into buffer (e.g. the
+   * publish buffer of an MQTT client) without allocation. length is the
+   * length of the whole message, it is truncated if length >= size.
+   */
+  void setMessageCallback(MessageCallBack callback, char *buffer, size_t size);
+
+  /**
+   * Like setCallback(), but every message is printed to output, before
+   * callback is called with message nullptr and its length.
+   */
+  void setMessageCallback(MessageCallBack callback, Print &output);
+
   /**
    * If set to true, the receiver will temporarely be disabled when sending.
    */
   void setEchoEnabled(bool enabled);
 
+  /**
+   * Verify messages of send(), sendAsync() and the command functions by
+   * their echo. Requires setEchoEnabled(true) and the receiver. An echo is
+   * verified, if the sent protocol decodes the same message from it as
+   * from the sent pulse train. After echoes verified echoes, the remaining
+   * repeats of a transmission sent by the timer are dropped. 0 disables
+   * verification (default).
+   */
+  void setEchoVerification(uint8_t echoes);
+
+  /**
+   * Echo statistics of protocol, e.g. the success rate
+   * confirmed / transmissions.
+   */
+  static EchoStats_t echoStats(const String &protocol);
+  static void clearEchoStats();
+
+  /**
+   * If set to true, pulse trains are rescaled per protocol before decoding,
+   * when their base pulse length (the median of the short pulses) or their
+   * footer is up to ADAPTIVE_TIMING_TOLERANCE percent outside the range of
+   * the protocol. This recovers frames of transmitters with drifting clocks
+   * (e.g. cold batteries).
+   */
+  void setAdaptiveTimingEnabled(bool enabled);
+
+  /**
+   * If set to true, only the interpretation with the highest confidence is
+   * passed to the callback when several protocols decode the same pulse
+   * train. Otherwise, every decoded message is passed.
+   */
+  void setBestMatchEnabled(bool enabled);
+
+  /**
+   * Confidence (0 to 100) of the message currently passed to the callback.
+   * It rates the timing of the pulse train against the protocol and whether
+   * the protocol verified a checksum.
+   */
+  uint8_t confidence() const;
+
   /**
    * Initialise receiver
    */
   static void initReceiver(byte inputPin);
 
   /**
-   * Get last received PulseTrain.
+   * Get last received PulseTrain. Its last pulse is the gap which ended it
+   * (the footer, if it is within maxgaplen), like pilight protocols expect.
    * Returns: length of PulseTrain or 0 if not avaiable
    */
   static uint8_t receivePulseTrain(uint16_t *pulses);
@@ -112,6 +338,13 @@ class ESPiLight {
    */
   static void interruptHandler();
 
+  /**
+   * Pass an edge of the input signal at time (in microseconds) to the
+   * receiver, like interruptHandler() does at micros(). Used to replay
+   * recorded or simulated signals.
+   */
+  static void receiveEdge(unsigned long time);
+
   /**
    * Limit the available protocols.
    *
@@ -120,6 +353,24 @@ class ESPiLight {
    */
   static void limitProtocols(const String &protos);
 
+  /**
+   * Load pilight device settings, like temperature or humidity offsets.
+   *
+   * This gets a json object (or array) of devices in the pilight config
+   * format. Every device is passed to the checkValues() function of its
+   * protocols, e.g.:
+   * {"outside":{"protocol":["tfa"],"id":[{"id":42,"channel":1}],
+   *             "temperature-offset":-1.5}}
+   * Previously loaded settings are discarded. Returns the number of loaded
+   * devices, ERROR_INVALID_JSON or ERROR_OUT_OF_MEMORY.
+   */
+  static int loadDevices(const String &devices);
+
+  /**
+   * Discard all device settings loaded by loadDevices().
+   */
+  static void clearDevices();
+
   /**
    * Return a json array containing all the available protocols.
    */
@@ -130,6 +381,76 @@ class ESPiLight {
    */
   static String enabledProtocols();
 
+  /**
+   * Limit the airtime of the transmitter to permille of a rolling window of
+   * windowMs milliseconds, e.g. setDutyCycle(10, 3600000) for 1 % per hour.
+   * Queued transmissions wait until airtime is available again. A permille
+   * of 0 disables the limit (default).
+   */
+  static void setDutyCycle(uint16_t permille, uint32_t windowMs = 3600000);
+
+  /**
+   * Airtime in microseconds used within the rolling window.
+   */
+  static uint32_t airtime();
+
+  /**
+   * Listen for listenUs before every burst of TX_QUEUE_BURST repeats, with
+   * the receiver enabled, and defer the burst up to maxDeferUs while the
+   * receiver captures a frame. The receiver is also enabled during the gaps
+   * of a transmission. Has no effect with setEchoEnabled(true). A listenUs
+   * of 0 disables it (default).
+   */
+  static void setListenBeforeTransmit(uint16_t listenUs,
+                                      uint32_t maxDeferUs = 250000);
+
+  /**
+   * Time in microseconds the receiver was disabled by transmissions. If
+   * reset is true, it is cleared.
+   */
+  static uint32_t deafTime(bool reset = false);
+
+  /**
+   * If set to true, every edge is sent at an absolute deadline from the
+   * start of the frame. The time taken by digitalWrite() and interrupts
+   * is compensated instead of stretching the frame.
+   */
+  static void setPreciseTimingEnabled(bool enabled);
+
+  /**
+   * Timing error of the frames transmitted since the last reset, measured
+   * in both modes. If reset is true, the statistics are cleared.
+   */
+  static TransmitTiming_t transmitTiming(bool reset = false);
+
+  /**
+   * Replace the transmitter hardware by a simulation, e.g. on a host without
+   * radio. Transmissions are completed immediately on a virtual clock.
+   * Every output write, including repeats and gaps, is stored to edges (up
+   * to size) and printed to output ("time pin level" lines), if not
+   * nullptr. If loopback is true, the edges are passed to receiveEdge(),
+   * like to the receiver of a real radio next to the transmitter: the
+   * receiver must be enabled and setEchoEnabled(true) must be set.
+   */
+  static void beginSimulation(SimulatedEdge_t *edges, size_t size,
+                              Print *output = nullptr, bool loopback = false);
+
+  /**
+   * Restore the transmitter hardware.
+   */
+  static void endSimulation();
+
+  /**
+   * Number of output writes since beginSimulation(), including those that
+   * did not fit into edges.
+   */
+  static size_t simulatedEdges();
+
+  /**
+   * Virtual time of the simulation in microseconds.
+   */
+  static uint32_t simulationTime();
+
   /**
    * Set pilight error output Print class (default is Serial)
    */
@@ -147,16 +468,58 @@ class ESPiLight {
                                 size_t maxlength);
   static int stringToRepeats(const String &data);
 
+  /**
+   * Pack a pulse train into frame, see tx_frame_encode(). Returns length or
+   * ERROR_INEXACT_PULSETRAIN, if pulses were truncated to
+   * MAXPULSESTREAMLENGTH or similar durations were merged to fit into
+   * TX_PULSE_TYPES types. frame is packed in both cases. The largest timing
+   * deviation in microseconds is stored to deviation, if not nullptr.
+   */
+  static int compressPulseTrain(CompactPulseTrain_t *frame,
+                                const uint16_t *pulses, size_t length,
+                                uint32_t *deviation = nullptr);
+
+  /**
+   * Unpack frame into pulses (MAXPULSESTREAMLENGTH). Returns the length.
+   */
+  static size_t expandPulseTrain(const CompactPulseTrain_t *frame,
+                                 uint16_t *pulses);
+
   static int createPulseTrain(uint16_t *pulses, const String &protocol_id,
                               const String &json);
 
   /**
-   * Error return codes for send() and createPulseTrain()
+   * Return the protocol with name, or nullptr. The protocol is a handle for
+   * the typed createPulseTrain().
+   */
+  static struct protocol_t *findProtocol(const String &name);
+
+  /**
+   * Create the pulse train of a typed message without any json. If the
+   * protocol rejects the arguments, ERROR_INVALID_PILIGHT_MSG is returned
+   * and the names of missing arguments are stored to missing (up to
+   * maxMissing, terminated by nullptr if there is space left). Nothing is
+   * logged.
+   */
+  static int createPulseTrain(uint16_t *pulses, struct protocol_t *protocol,
+                              const PilightArg_t *args, size_t nargs,
+                              const char **missing = nullptr,
+                              size_t maxMissing = 0);
+
+  /**
+   * Error return codes for send(), sendAsync(), sendPulseTrain(),
+   * sendPulseTrainAsync(), compressPulseTrain(), createPulseTrain(),
+   * registerCommand(), sendCommand() and loadDevices()
    */
   static const int ERROR_UNAVAILABLE_PROTOCOL = 0;
   static const int ERROR_INVALID_PILIGHT_MSG = -1;
   static const int ERROR_INVALID_JSON = -2;
   static const int ERROR_NO_OUTPUT_PIN = -3;
+  static const int ERROR_TRANSMITTER_BUSY = -4;  // transmit queue is full
+  static const int ERROR_CACHE_FULL = -5;
+  static const int ERROR_UNKNOWN_COMMAND = -6;
+  static const int ERROR_OUT_OF_MEMORY = -7;  // a json allocation failed
+  static const int ERROR_INEXACT_PULSETRAIN = -8;  // pulses were altered
 
   /**
    * Error return codes for stringToPulseTrain()
@@ -170,8 +533,44 @@ class ESPiLight {
  private:
   ESPiLightCallBack _callback;
   PulseTrainCallBack _rawCallback;
-  int8_t _outputPin;
+  MessageCallBack _messageCallback;
+  char *_messageBuffer;
+  size_t _messageSize;
+  Print *_messageOutput;
+  TransmitOutput_t _output;
   bool _echoEnabled;
+  bool _adaptiveTiming;
+  bool _bestMatch;
+  uint8_t _confidence;
+  uint8_t _echoVerification;
+  TransmitCallBack _transmitCallback;
+
+  int enqueuePulseTrain(const CompactPulseTrain_t *frame, size_t repeats,
+                        uint8_t priority, uint16_t gap, bool notify);
+
+  /**
+   * Queue frame of protocol (may be nullptr) and register it for echo
+   * verification. Unless async, wait for the transmission.
+   */
+  int transmit(struct protocol_t *protocol, const CompactPulseTrain_t *frame,
+               size_t repeats, uint8_t priority, uint16_t gap, bool async);
+
+  /**
+   * Parse the next (or with all, every) received pulse train.
+   */
+  void processReceived(bool all);
+
+  /**
+   * Called when the transmitter starts (true) or stops (false) keying,
+   * possibly from the timer interrupt. Disables the receiver meanwhile.
+   */
+  static void transmitState(bool active);
+
+  /**
+   * Returns true while the receiver captures a frame. Called by the
+   * transmitter before a burst, possibly from the timer interrupt.
+   */
+  static bool receiving(unsigned long now);
 
   /**
    * Quasi-reset. Called when the current edge is too long or short.
@@ -186,6 +585,10 @@ class ESPiLight {
   static bool _enabledReceiver;  // If true, monitoring and decoding is
                                  // enabled. If false, interruptHandler will
                                  // return immediately.
+  static volatile bool _receiverState;  // _enabledReceiver while sending
+  static bool _echoTransmit;  // _echoEnabled of the transmitting instance
+  static volatile unsigned long _deafSince;
+  static volatile uint32_t _deafTime;  // receiver disabled by transmissions
   static volatile PulseTrain_t _pulseTrains[];
   static volatile uint8_t _actualPulseTrain;
   static uint8_t _avaiablePulseTrain;
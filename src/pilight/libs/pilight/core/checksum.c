@@ -0,0 +1,162 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#include "checksum.h"
+
+size_t bits_to_bytes(const int *binary, int s, int e, uint8_t *bytes) {
+  size_t len = 0;
+  uint8_t byte = 0;
+  int i = 0;
+
+  for(i=s;i<=e;i++) {
+    byte = (uint8_t)(byte << 1) | (binary[i] != 0);
+    if(((i - s) & 7) == 7) {
+      bytes[len++] = byte;
+      byte = 0;
+    }
+  }
+  if(((e - s + 1) & 7) != 0) {
+    bytes[len++] = (uint8_t)(byte << (8 - ((e - s + 1) & 7)));
+  }
+  return len;
+}
+
+size_t bits_to_bytes_rev(const int *binary, int s, int e, uint8_t *bytes) {
+  size_t len = 0;
+  uint8_t byte = 0;
+  int i = 0;
+
+  for(i=s;i<=e;i++) {
+    if(binary[i] != 0) {
+      byte |= (uint8_t)(1 << ((i - s) & 7));
+    }
+    if(((i - s) & 7) == 7) {
+      bytes[len++] = byte;
+      byte = 0;
+    }
+  }
+  if(((e - s + 1) & 7) != 0) {
+    bytes[len++] = byte;
+  }
+  return len;
+}
+
+uint8_t xor_bytes(const uint8_t *bytes, size_t len) {
+  uint8_t result = 0;
+  while(len--) {
+    result ^= *bytes++;
+  }
+  return result;
+}
+
+uint8_t add_nibbles(const uint8_t *bytes, size_t nibbles) {
+  uint8_t result = 0;
+  size_t i = 0;
+
+  for(i=0;i<nibbles/2;i++) {
+    result += (bytes[i] >> 4) + (bytes[i] & 0xf);
+  }
+  if(nibbles & 1) {
+    result += bytes[i] >> 4;
+  }
+  return result;
+}
+
+uint8_t parity8(uint8_t byte) {
+  byte ^= byte >> 4;
+  byte &= 0xf;
+  return (0x6996 >> byte) & 0x01;
+}
+
+static uint8_t crc4_rev_bit(uint8_t poly, uint8_t crc, int bit) {
+  crc ^= (uint8_t)bit;
+  return (crc & 1) ? ((crc >> 1) ^ poly) : (crc >> 1);
+}
+
+void crc4_rev_init(crc4_t *crc, uint8_t poly) {
+  uint8_t i = 0, x = 0;
+
+  crc->poly = poly;
+  for(i=0;i<16;i++) {
+    uint8_t reg = i;
+    for(x=0;x<4;x++) {
+      reg = crc4_rev_bit(poly, reg, 0);
+    }
+    crc->table[i] = reg;
+  }
+}
+
+uint8_t crc4_rev(const crc4_t *crc, const uint8_t *bytes, size_t bits,
+                 uint8_t init) {
+  uint8_t reg = init & 0xf;
+  size_t i = 0;
+
+  for(i=0;i+8<=bits;i+=8) {
+    reg = crc->table[(reg ^ *bytes) & 0xf];
+    reg = crc->table[(reg ^ (*bytes >> 4)) & 0xf];
+    bytes++;
+  }
+  for(;i<bits;i++) {
+    reg = crc4_rev_bit(crc->poly, reg, (*bytes >> (i & 7)) & 1);
+  }
+  return reg;
+}
+
+static uint8_t lfsr4_shift(uint8_t gen, uint8_t key) {
+  return (key & 1) ? ((key >> 1) ^ gen) : (key >> 1);
+}
+
+void lfsr_digest4_init(lfsr4_t *lfsr, uint8_t gen) {
+  uint8_t key = 0, nibble = 0, x = 0;
+
+  lfsr->gen = gen;
+  for(key=0;key<16;key++) {
+    for(nibble=0;nibble<16;nibble++) {
+      uint8_t reg = key, digest = 0;
+      for(x=0;x<4;x++) {
+        reg = lfsr4_shift(gen, reg);
+        if(nibble & (0x8 >> x)) {
+          digest ^= reg;
+        }
+      }
+      lfsr->digest[key][nibble] = digest;
+    }
+    lfsr->next[key] = lfsr4_shift(gen, lfsr4_shift(gen,
+                      lfsr4_shift(gen, lfsr4_shift(gen, key))));
+  }
+}
+
+uint8_t lfsr_digest4(const lfsr4_t *lfsr, const uint8_t *bytes, size_t bits,
+                     uint8_t key) {
+  uint8_t digest = 0;
+  size_t i = 0;
+
+  key &= 0xf;
+  for(i=0;i+4<=bits;i+=4) {
+    uint8_t nibble = (i & 4) ? (bytes[i/8] & 0xf) : (bytes[i/8] >> 4);
+    digest ^= lfsr->digest[key][nibble];
+    key = lfsr->next[key];
+  }
+  for(;i<bits;i++) {
+    key = lfsr4_shift(lfsr->gen, key);
+    if((bytes[i/8] >> (7 - (i & 7))) & 1) {
+      digest ^= key;
+    }
+  }
+  return digest;
+}
@@ -0,0 +1,72 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _CHECKSUM_H_
+#define _CHECKSUM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Pack "bits", each represented by an int in a buffer (non-zero = "1"), into
+ * bytes. An incomplete last byte is padded with zeros.
+ * bits_to_bytes() stores binary[s] as the most significant bit of bytes[0],
+ * bits_to_bytes_rev() stores binary[s] as the least significant bit.
+ * @return size_t The number of bytes written.
+ */
+size_t bits_to_bytes(const int *binary, int s, int e, uint8_t *bytes);
+size_t bits_to_bytes_rev(const int *binary, int s, int e, uint8_t *bytes);
+
+/*
+ * Simple checksums over packed bytes. For an odd number of nibbles,
+ * add_nibbles() expects bytes packed by bits_to_bytes().
+ */
+uint8_t xor_bytes(const uint8_t *bytes, size_t len);
+uint8_t add_nibbles(const uint8_t *bytes, size_t nibbles);
+uint8_t parity8(uint8_t byte);
+
+/*
+ * Nibble table driven CRC-4 of bytes packed with bits_to_bytes_rev(), i.e.
+ * the bits are fed least significant bit first (reflected CRC).
+ * crc4_rev_init() fills the table for the reflected polynomial "poly".
+ */
+typedef struct crc4_t {
+  uint8_t poly;
+  uint8_t table[16];
+} crc4_t;
+
+void crc4_rev_init(crc4_t *crc, uint8_t poly);
+uint8_t crc4_rev(const crc4_t *crc, const uint8_t *bytes, size_t bits,
+                 uint8_t init);
+
+/*
+ * Nibble table driven 4 bit LFSR digest of bytes packed with bits_to_bytes().
+ * For every bit the key is shifted right and xored with "gen" if a one was
+ * shifted out, every set bit of the message xors the key into the digest.
+ */
+typedef struct lfsr4_t {
+  uint8_t gen;
+  uint8_t next[16];         /* key after four shifts */
+  uint8_t digest[16][16];   /* [key][nibble] */
+} lfsr4_t;
+
+void lfsr_digest4_init(lfsr4_t *lfsr, uint8_t gen);
+uint8_t lfsr_digest4(const lfsr4_t *lfsr, const uint8_t *bytes, size_t bits,
+                     uint8_t key);
+
+#endif
@@ -31,19 +31,311 @@
 #include "json.h"
 #include "mem.h"
 
-#define out_of_memory() do {                    \
-		fprintf(stderr, "Out of memory.\n");    \
-		exit(EXIT_FAILURE);                     \
-	} while (0)
+/* Arena */
 
-/* Sadly, strdup is not portable. */
-static char *json_strdup(const char *str)
+/*
+ * The first block holds the arena itself, further blocks are linked by
+ * their first word. The latest allocation may grow in place.
+ */
+struct JsonArena
+{
+	JsonArena *prev; /* enclosing arena of json_arena_begin() */
+	char *blocks;
+	char *cur;
+	char *end;
+	char *last;
+	size_t size;
+	int roots; /* nodes without parent */
+	bool open;
+};
+
+/* Arena of json_arena_begin(), NULL for the heap */
+static JsonArena *json_arena = NULL;
+
+/*
+ * Current arena after a failed json_arena_begin(), in which every
+ * allocation fails, until the dead_depth nested json_arena_end() calls.
+ */
+static JsonArena dead_arena;
+static int dead_depth = 0;
+
+#define ARENA_ALIGN sizeof(double)
+#define arena_align(n) (((n) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+/* Pools */
+
+static JsonPoolStats pool_stats;
+
+/*
+ * Unused pool entries are taken in order first, released ones are linked
+ * by their first word. Requests a pool cannot serve are taken from the heap.
+ */
+#if JSON_POOL_NODES > 0
+static JsonNode pool_nodes[JSON_POOL_NODES];
+static JsonNode *pool_nodes_free = NULL;
+static size_t pool_nodes_next = 0;
+#endif
+
+/* The first block of an arena holds the arena itself */
+#define POOL_BLOCK_SIZE (arena_align(sizeof(JsonArena)) + JSON_ARENA_SIZE)
+
+#if JSON_POOL_BLOCKS > 0
+static double pool_blocks[JSON_POOL_BLOCKS][(POOL_BLOCK_SIZE + sizeof(double) - 1) / sizeof(double)];
+static char *pool_blocks_free = NULL;
+static size_t pool_blocks_next = 0;
+#endif
+
+static JsonNode *node_alloc(void)
 {
-	char *ret = (char*) MALLOC(strlen(str) + 1);
+	JsonNode *ret = NULL;
+
+#if JSON_POOL_NODES > 0
+	if (pool_nodes_free != NULL) {
+		ret = pool_nodes_free;
+		pool_nodes_free = *(JsonNode **)ret;
+	} else if (pool_nodes_next < JSON_POOL_NODES) {
+		ret = &pool_nodes[pool_nodes_next++];
+	}
+	if (ret != NULL)
+		memset(ret, 0, sizeof(JsonNode));
+	else
+		pool_stats.heap++;
+#endif
 	if (ret == NULL)
-		out_of_memory(); /*LCOV_EXCL_LINE*/
-	memset(ret, 0, strlen(str) + 1);
-	strcpy(ret, str);
+		ret = (JsonNode*) CALLOC(1, sizeof(JsonNode));
+	if (ret == NULL) {
+		pool_stats.failures++;
+		return NULL;
+	}
+	if (++pool_stats.nodes > pool_stats.nodes_peak)
+		pool_stats.nodes_peak = pool_stats.nodes;
+	return ret;
+}
+
+static void node_free(JsonNode *node)
+{
+	pool_stats.nodes--;
+#if JSON_POOL_NODES > 0
+	if (node >= pool_nodes && node < pool_nodes + JSON_POOL_NODES) {
+		*(JsonNode **)node = pool_nodes_free;
+		pool_nodes_free = node;
+		return;
+	}
+#endif
+	FREE(node);
+}
+
+static void *block_alloc(size_t size)
+{
+	void *ret = NULL;
+
+#if JSON_POOL_BLOCKS > 0
+	if (size <= POOL_BLOCK_SIZE) {
+		if (pool_blocks_free != NULL) {
+			ret = pool_blocks_free;
+			pool_blocks_free = *(char **)ret;
+		} else if (pool_blocks_next < JSON_POOL_BLOCKS) {
+			ret = pool_blocks[pool_blocks_next++];
+		}
+	}
+	if (ret == NULL)
+		pool_stats.heap++;
+#endif
+	if (ret == NULL)
+		ret = MALLOC(size);
+	if (ret == NULL) {
+		pool_stats.failures++;
+		return NULL;
+	}
+	if (++pool_stats.blocks > pool_stats.blocks_peak)
+		pool_stats.blocks_peak = pool_stats.blocks;
+	return ret;
+}
+
+static void block_free(void *block)
+{
+	pool_stats.blocks--;
+#if JSON_POOL_BLOCKS > 0
+	if ((char*) block >= (char*) pool_blocks &&
+	    (char*) block < (char*) (pool_blocks + JSON_POOL_BLOCKS)) {
+		*(char **)block = pool_blocks_free;
+		pool_blocks_free = (char*) block;
+		return;
+	}
+#endif
+	FREE(block);
+}
+
+void json_pool_stats(JsonPoolStats *stats, bool reset)
+{
+	*stats = pool_stats;
+	if (reset) {
+		pool_stats.nodes_peak = pool_stats.nodes;
+		pool_stats.blocks_peak = pool_stats.blocks;
+	}
+}
+
+static void *arena_alloc(JsonArena *arena, size_t size, size_t align)
+{
+	char *p = (char*) (((uintptr_t)arena->cur + align - 1) & ~(uintptr_t)(align - 1));
+
+	if (p > arena->end || (size_t)(arena->end - p) < size) {
+		size_t alloc = size > arena->size ? size : arena->size;
+		char *block;
+
+		if (arena == &dead_arena) {
+			pool_stats.failures++;
+			return NULL;
+		}
+		block = (char*) block_alloc(arena_align(sizeof(char *)) + alloc);
+		if (block == NULL)
+			return NULL;
+		*(char **)block = arena->blocks;
+		arena->blocks = block;
+		p = block + arena_align(sizeof(char *));
+		arena->end = p + alloc;
+	}
+	arena->last = p;
+	arena->cur = p + size;
+	return p;
+}
+
+static void *arena_realloc(JsonArena *arena, void *ptr, size_t old, size_t size)
+{
+	char *ret;
+
+	if (ptr == arena->last && (size_t)(arena->end - arena->last) >= size) {
+		arena->cur = arena->last + size;
+		return ptr;
+	}
+	ret = (char*) arena_alloc(arena, size, 1);
+	if (ret != NULL)
+		memcpy(ret, ptr, old);
+	return ret;
+}
+
+/* Return the unused end of the latest allocation */
+static void arena_trim(JsonArena *arena, void *ptr, size_t size)
+{
+	if (ptr == arena->last)
+		arena->cur = arena->last + size;
+}
+
+static void arena_release(JsonArena *arena)
+{
+	char *block = arena->blocks;
+
+	while (block != NULL) {
+		char *next = *(char **)block;
+		block_free(block);
+		block = next;
+	}
+	block_free(arena);
+}
+
+void json_arena_begin(size_t size)
+{
+	JsonArena *arena;
+
+	if (json_arena == &dead_arena) {
+		dead_depth++;
+		return;
+	}
+	if (size == 0)
+		size = JSON_ARENA_SIZE;
+	arena = (JsonArena*) block_alloc(arena_align(sizeof(JsonArena)) + size);
+	if (arena == NULL) {
+		dead_arena.prev = json_arena;
+		dead_depth = 1;
+		json_arena = &dead_arena;
+		return;
+	}
+	arena->prev = json_arena;
+	arena->blocks = NULL;
+	arena->cur = (char*) arena + arena_align(sizeof(JsonArena));
+	arena->end = arena->cur + size;
+	arena->last = NULL;
+	arena->size = size;
+	arena->roots = 0;
+	arena->open = true;
+	json_arena = arena;
+}
+
+void json_arena_end(void)
+{
+	JsonArena *arena = json_arena;
+
+	if (arena == NULL)
+		return;
+	if (arena == &dead_arena) {
+		if (--dead_depth == 0)
+			json_arena = dead_arena.prev;
+		return;
+	}
+	json_arena = arena->prev;
+	arena->open = false;
+	if (arena->roots == 0)
+		arena_release(arena);
+}
+
+/* Key index */
+
+/*
+ * Open addressing hash table of the members of an object. A key is stored
+ * once, at its first member, so lookups find the same member as a walk.
+ */
+struct JsonIndex
+{
+	size_t mask; /* number of slots - 1 */
+	JsonNode *slots[];
+};
+
+static size_t index_hash(const char *key)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*key != '\0')
+		hash = (hash ^ (unsigned char)*key++) * 16777619u;
+	return hash;
+}
+
+static JsonNode *index_lookup(const JsonIndex *index, const char *key)
+{
+	size_t i = index_hash(key) & index->mask;
+
+	while (index->slots[i] != NULL) {
+		if (strcmp(index->slots[i]->key, key) == 0)
+			return index->slots[i];
+		i = (i + 1) & index->mask;
+	}
+	return NULL;
+}
+
+static void index_drop(JsonNode *object)
+{
+	if (object->tag == JSON_OBJECT && object->children.index != NULL) {
+		/* Arena indexes are released with the arena. */
+		if (object->arena_ == NULL)
+			FREE(object->children.index);
+		object->children.index = NULL;
+	}
+}
+
+/* Sadly, strdup is not portable. */
+static char *json_strdup(JsonArena *arena, const char *str)
+{
+	size_t len = strlen(str) + 1;
+	char *ret;
+
+	if (arena != NULL) {
+		ret = (char*) arena_alloc(arena, len, 1);
+	} else {
+		ret = (char*) MALLOC(len);
+		if (ret == NULL)
+			pool_stats.failures++;
+	}
+	if (ret != NULL)
+		memcpy(ret, str, len);
 	return ret;
 }
 
@@ -54,14 +346,102 @@ typedef struct
 	char *cur;
 	char *end;
 	char *start;
+	JsonArena *arena; /* NULL for the heap */
+
+	/*
+	 * Streaming: instead of growing, the full buffer is passed to write.
+	 * A fixed buffer continues as stream, which fills up its rest.
+	 */
+	JsonWriteCallback write;
+	void *arg;
+	size_t length; /* passed to write */
+	bool fixed;
+	bool failed; /* an allocation failed, the rest is discarded */
+	char *fill;
+	char *fill_end;
+	char chunk[32];
 } SB;
 
-static void sb_init(SB *sb)
+static void sb_fill(void *arg, const char *bytes, size_t count)
+{
+	SB *sb = (SB*) arg;
+	size_t n = sb->fill_end - sb->fill;
+
+	if (n > count)
+		n = count;
+	memcpy(sb->fill, bytes, n);
+	sb->fill += n;
+	*sb->fill = 0;
+}
+
+static void sb_discard(void *arg, const char *bytes, size_t count)
 {
-	sb->start = (char*) MALLOC(17);
-	memset(sb->start, 0, 17);
-	if (sb->start == NULL)
-		out_of_memory(); /*LCOV_EXCL_LINE*/
+	(void)arg;
+	(void)bytes;
+	(void)count;
+}
+
+static void sb_init_stream(SB *sb, JsonWriteCallback write, void *arg)
+{
+	sb->arena = NULL;
+	sb->write = write;
+	sb->arg = arg;
+	sb->length = 0;
+	sb->fixed = false;
+	sb->failed = false;
+	sb->start = sb->cur = sb->chunk;
+	sb->end = sb->chunk + sizeof(sb->chunk);
+}
+
+static void sb_init_fixed(SB *sb, char *buf, size_t size)
+{
+	if (size == 0) {
+		sb_init_stream(sb, sb_discard, NULL);
+		return;
+	}
+	sb_init_stream(sb, NULL, NULL);
+	sb->fixed = true;
+	sb->start = sb->cur = buf;
+	sb->end = buf + size - 1;
+}
+
+static void sb_flush(SB *sb)
+{
+	if (sb->cur > sb->start)
+		sb->write(sb->arg, sb->start, sb->cur - sb->start);
+	sb->length += sb->cur - sb->start;
+	sb->cur = sb->start;
+}
+
+/* Release the buffer of sb after a failed allocation and discard the rest */
+static void sb_fail(SB *sb)
+{
+	if (sb->arena == NULL) {
+		if (sb->start != NULL)
+			FREE(sb->start);
+		pool_stats.failures++;
+	}
+	sb_init_stream(sb, sb_discard, NULL);
+	sb->failed = true;
+}
+
+static void sb_init(SB *sb, JsonArena *arena)
+{
+	sb->write = NULL;
+	sb->fixed = false;
+	sb->failed = false;
+	sb->arena = arena;
+	if (arena != NULL) {
+		sb->start = (char*) arena_alloc(arena, 17, 1);
+	} else {
+		sb->start = (char*) MALLOC(17);
+		if (sb->start != NULL)
+			memset(sb->start, 0, 17);
+	}
+	if (sb->start == NULL) {
+		sb_fail(sb);
+		return;
+	}
 	sb->cur = sb->start;
 	sb->end = sb->start + 16;
 }
@@ -76,14 +456,38 @@ static void sb_grow(SB *sb, int need)
 {
 	size_t length = sb->cur - sb->start;
 	size_t alloc = sb->end - sb->start;
+	char *start;
+
+	if (sb->fixed) {
+		*sb->cur = 0;
+		sb->length = length;
+		sb->fixed = false;
+		sb->write = sb_fill;
+		sb->arg = sb;
+		sb->fill = sb->cur;
+		sb->fill_end = sb->end;
+		sb->start = sb->cur = sb->chunk;
+		sb->end = sb->chunk + sizeof(sb->chunk);
+		return;
+	}
+	if (sb->write != NULL) {
+		sb_flush(sb);
+		return;
+	}
 
 	do {
 		alloc *= 2;
 	} while (alloc < length + need);
 
-	sb->start = (char*) REALLOC(sb->start, alloc + 1);
-	if (sb->start == NULL)
-		out_of_memory(); /*LCOV_EXCL_LINE*/
+	if (sb->arena != NULL)
+		start = (char*) arena_realloc(sb->arena, sb->start, length, alloc + 1);
+	else
+		start = (char*) REALLOC(sb->start, alloc + 1);
+	if (start == NULL) {
+		sb_fail(sb);
+		return;
+	}
+	sb->start = start;
 	sb->cur = sb->start + length;
 	sb->end = sb->start + alloc;
 }
@@ -91,6 +495,13 @@ static void sb_grow(SB *sb, int need)
 static void sb_put(SB *sb, const char *bytes, int count)
 {
 	sb_need(sb, count);
+	if (sb->end - sb->cur < count) {
+		/* Streaming, more than a chunk */
+		sb_flush(sb);
+		sb->write(sb->arg, bytes, count);
+		sb->length += count;
+		return;
+	}
 	memcpy(sb->cur, bytes, count);
 	sb->cur += count;
 }
@@ -108,14 +519,23 @@ static void sb_puts(SB *sb, const char *str)
 
 static char *sb_finish(SB *sb)
 {
+	if (sb->failed)
+		return NULL;
 	*sb->cur = 0;
 	assert(sb->start <= sb->cur && strlen(sb->start) == (size_t)(sb->cur - sb->start));
+	if (sb->arena != NULL)
+		arena_trim(sb->arena, sb->start, sb->cur - sb->start + 1);
 	return sb->start;
 }
 
 static void sb_free(SB *sb)
 {
-	FREE(sb->start);
+	if (sb->failed)
+		return;
+	if (sb->arena != NULL)
+		arena_trim(sb->arena, sb->start, 0);
+	else
+		FREE(sb->start);
 }
 
 /*
@@ -362,21 +782,49 @@ static void append_member(JsonNode *object, char *key, JsonNode *value);
 static bool tag_is_valid(unsigned int tag);
 static bool number_is_valid(const char *num);
 
+/* Error and input of json_parse(), NULL otherwise */
+static JsonError *parse_error = NULL;
+static const char *parse_start = NULL;
+
+/* Record the first, i.e. innermost, error of json_parse() at s. */
+static void parse_fail(const char *s, int code)
+{
+	if (parse_error == NULL || parse_error->code != JSON_ERROR_NONE)
+		return;
+	parse_error->code = (*s == '\0' && code != JSON_ERROR_MEMORY) ? JSON_ERROR_END : code;
+	parse_error->position = s - parse_start;
+}
+
 JsonNode *json_decode(const char *json)
+{
+	return json_parse(json, NULL);
+}
+
+JsonNode *json_parse(const char *json, JsonError *error)
 {
 	const char *s = json;
+	JsonError ignored;
 	JsonNode *ret;
 
-	skip_space(&s);
-	if (!parse_value(&s, &ret))
-		return NULL;
+	parse_error = (error != NULL) ? error : &ignored;
+	parse_error->code = JSON_ERROR_NONE;
+	parse_error->position = 0;
+	parse_start = json;
 
 	skip_space(&s);
-	if (*s != 0) {
-		json_delete(ret);
-		return NULL;
+	if (!parse_value(&s, &ret)) {
+		ret = NULL;
+	} else {
+		skip_space(&s);
+		if (*s != 0) {
+			parse_fail(s, JSON_ERROR_TRAILING);
+			json_delete(ret);
+			ret = NULL;
+		}
 	}
 
+	parse_error = NULL;
+	parse_start = NULL;
 	return ret;
 }
 
@@ -385,10 +833,36 @@ char *json_encode(const JsonNode *node)
 	return json_stringify(node, NULL);
 }
 
+size_t json_encode_buffer(const JsonNode *node, char *buf, size_t size)
+{
+	SB sb;
+	sb_init_fixed(&sb, buf, size);
+
+	emit_value(&sb, node);
+
+	if (sb.fixed) {
+		*sb.cur = 0;
+		return sb.cur - sb.start;
+	}
+	sb_flush(&sb);
+	return sb.length;
+}
+
+size_t json_encode_writer(const JsonNode *node, JsonWriteCallback write, void *arg)
+{
+	SB sb;
+	sb_init_stream(&sb, write, arg);
+
+	emit_value(&sb, node);
+
+	sb_flush(&sb);
+	return sb.length;
+}
+
 char *json_encode_string(const char *str)
 {
 	SB sb;
-	sb_init(&sb);
+	sb_init(&sb, NULL);
 
 	emit_string(&sb, str);
 
@@ -398,7 +872,11 @@ char *json_encode_string(const char *str)
 char *json_stringify(const JsonNode *node, const char *space)
 {
 	SB sb;
-	sb_init(&sb);
+
+	/* e.g. of a failed allocation */
+	if (node == NULL)
+		return NULL;
+	sb_init(&sb, NULL);
 
 	if (space != NULL)
 		emit_value_indented(&sb, node, space, 0);
@@ -411,7 +889,15 @@ char *json_stringify(const JsonNode *node, const char *space)
 void json_delete(JsonNode *node)
 {
 	if (node != NULL) {
+		JsonArena *arena = node->arena_;
+
 		json_remove_from_parent(node);
+		if (arena != NULL) {
+			/* The descendants are released with the arena. */
+			if (--arena->roots == 0 && !arena->open)
+				arena_release(arena);
+			return;
+		}
 
 		switch (node->tag) {
 			case JSON_STRING:
@@ -425,12 +911,13 @@ void json_delete(JsonNode *node)
 					next = child->next;
 					json_delete(child);
 				}
+				index_drop(node);
 				break;
 			}
 			default:;
 		}
 
-		FREE(node);
+		node_free(node);
 	}
 }
 
@@ -451,6 +938,257 @@ bool json_validate(const char *json)
 	return true;
 }
 
+void json_reader_init(JsonReader *reader, const char *json)
+{
+	memset(reader, 0, sizeof(JsonReader));
+	reader->start = json;
+	reader->pos = json;
+}
+
+int json_read(JsonReader *reader, JsonToken *token)
+{
+	const char *s = reader->pos;
+	int event = JSON_EVENT_VALUE;
+
+	memset(token, 0, sizeof(JsonToken));
+	if (reader->error.code != JSON_ERROR_NONE)
+		return JSON_EVENT_ERROR;
+	parse_error = &reader->error;
+	parse_start = reader->start;
+
+	skip_space(&s);
+	if (reader->depth == 0) {
+		if (reader->more) {
+			if (*s != '\0') {
+				parse_fail(s, JSON_ERROR_TRAILING);
+				goto failed;
+			}
+			event = JSON_EVENT_END;
+			goto done;
+		}
+	} else {
+		bool object = (reader->objects >> (reader->depth - 1)) & 1;
+
+		if (*s == (object ? '}' : ']')) {
+			s++;
+			reader->depth--;
+			reader->more = true;
+			event = object ? JSON_EVENT_OBJECT_END : JSON_EVENT_ARRAY_END;
+			goto done;
+		}
+		if (reader->more) {
+			if (*s != ',') {
+				parse_fail(s, JSON_ERROR_TOKEN);
+				goto failed;
+			}
+			s++;
+			skip_space(&s);
+		}
+		if (object) {
+			token->key = s + 1;
+			if (!parse_string(&s, NULL))
+				goto failed;
+			token->key_length = s - token->key - 1;
+			skip_space(&s);
+			if (*s != ':') {
+				parse_fail(s, JSON_ERROR_TOKEN);
+				goto failed;
+			}
+			s++;
+			skip_space(&s);
+		}
+	}
+
+	switch (*s) {
+		case '{':
+		case '[':
+			if (reader->depth == JSON_READER_DEPTH) {
+				parse_fail(s, JSON_ERROR_LIMIT);
+				goto failed;
+			}
+			if (*s == '{') {
+				reader->objects |= 1UL << reader->depth;
+				event = JSON_EVENT_OBJECT;
+			} else {
+				reader->objects &= ~(1UL << reader->depth);
+				event = JSON_EVENT_ARRAY;
+			}
+			s++;
+			reader->depth++;
+			reader->more = false;
+			goto done;
+
+		case 'n':
+			token->tag = JSON_NULL;
+			if (!expect_literal(&s, "null")) {
+				parse_fail(s, JSON_ERROR_TOKEN);
+				goto failed;
+			}
+			break;
+
+		case 'f':
+		case 't':
+			token->tag = JSON_BOOL;
+			token->bool_ = (*s == 't');
+			if (!expect_literal(&s, token->bool_ ? "true" : "false")) {
+				parse_fail(s, JSON_ERROR_TOKEN);
+				goto failed;
+			}
+			break;
+
+		case '"':
+			token->tag = JSON_STRING;
+			token->string_ = s + 1;
+			if (!parse_string(&s, NULL))
+				goto failed;
+			token->length = s - token->string_ - 1;
+			break;
+
+		default:
+			token->tag = JSON_NUMBER;
+			if (!parse_number(&s, &token->number_, &token->decimals_))
+				goto failed;
+			break;
+	}
+	reader->more = true;
+
+done:
+	reader->pos = s;
+	parse_error = NULL;
+	parse_start = NULL;
+	return event;
+
+failed:
+	parse_error = NULL;
+	parse_start = NULL;
+	return JSON_EVENT_ERROR;
+}
+
+size_t json_unescape(const char *str, size_t length, char *buf, size_t size)
+{
+	const char *end = str + length;
+	size_t ret = 0;
+
+	/* str has been validated by json_read(). */
+	while (str < end) {
+		char tmp[4];
+		int len = 1;
+
+		if (*str != '\\') {
+			tmp[0] = *str++;
+		} else {
+			str++;
+			switch (*str++) {
+				case 'b': tmp[0] = '\b'; break;
+				case 'f': tmp[0] = '\f'; break;
+				case 'n': tmp[0] = '\n'; break;
+				case 'r': tmp[0] = '\r'; break;
+				case 't': tmp[0] = '\t'; break;
+				case 'u':
+				{
+					uint16_t uc, lc;
+					uchar_t unicode = 0;
+
+					parse_hex16(&str, &uc);
+					if (uc >= 0xD800 && uc <= 0xDFFF) {
+						str += 2;
+						parse_hex16(&str, &lc);
+						from_surrogate_pair(uc, lc, &unicode);
+					} else {
+						unicode = uc;
+					}
+					len = utf8_write_char(unicode, tmp);
+					break;
+				}
+				default:
+					tmp[0] = str[-1];
+			}
+		}
+
+		if (ret + len < size)
+			memcpy(buf + ret, tmp, len);
+		else if (ret < size)
+			size = ret + 1; /* do not complete a truncated character later */
+		ret += len;
+	}
+	if (size > 0)
+		buf[ret < size ? ret : size - 1] = '\0';
+	return ret;
+}
+
+JsonNode *json_parse_flat(const char *json, JsonNode *nodes, size_t count, char *buf, size_t size, JsonError *error)
+{
+	JsonReader reader;
+	JsonToken token;
+	JsonNode *object = nodes;
+	size_t used = 1;
+	size_t fill = 0;
+	int event;
+
+	json_reader_init(&reader, json);
+	if (count == 0)
+		goto limit;
+
+	event = json_read(&reader, &token);
+	if (event != JSON_EVENT_OBJECT)
+		goto not_flat;
+	memset(object, 0, sizeof(JsonNode));
+	object->tag = JSON_OBJECT;
+
+	while ((event = json_read(&reader, &token)) == JSON_EVENT_VALUE) {
+		JsonNode *node;
+		size_t len;
+
+		if (used == count)
+			goto limit;
+		node = &nodes[used++];
+		memset(node, 0, sizeof(JsonNode));
+
+		len = json_unescape(token.key, token.key_length, buf + fill, size - fill);
+		if (fill + len >= size)
+			goto limit;
+		append_member(object, buf + fill, node);
+		fill += len + 1;
+
+		node->tag = token.tag;
+		if (token.tag == JSON_STRING) {
+			len = json_unescape(token.string_, token.length, buf + fill, size - fill);
+			if (fill + len >= size)
+				goto limit;
+			node->string_ = buf + fill;
+			fill += len + 1;
+		} else if (token.tag == JSON_NUMBER) {
+			node->number_ = token.number_;
+			node->decimals_ = token.decimals_;
+		} else if (token.tag == JSON_BOOL) {
+			node->bool_ = token.bool_;
+		}
+	}
+	if (event != JSON_EVENT_OBJECT_END)
+		goto not_flat;
+
+	event = json_read(&reader, &token);
+	if (event != JSON_EVENT_END)
+		goto not_flat;
+
+	if (error != NULL)
+		*error = reader.error;
+	return object;
+
+not_flat:
+	if (event == JSON_EVENT_ERROR) {
+		if (error != NULL)
+			*error = reader.error;
+		return NULL;
+	}
+limit:
+	if (error != NULL) {
+		error->code = JSON_ERROR_LIMIT;
+		error->position = reader.pos - json;
+	}
+	return NULL;
+}
+
 JsonNode *json_find_element(JsonNode *array, int index)
 {
 	JsonNode *element;
@@ -475,6 +1213,9 @@ JsonNode *json_find_member(JsonNode *object, const char *name)
 	if (object == NULL || object->tag != JSON_OBJECT)
 		return NULL;
 
+	if (object->children.index != NULL)
+		return index_lookup(object->children.index, name);
+
 	json_foreach(member, object)
 		if (strcmp(member->key, name) == 0)
 			return member;
@@ -482,6 +1223,83 @@ JsonNode *json_find_member(JsonNode *object, const char *name)
 	return NULL;
 }
 
+size_t json_find_members(JsonNode *object, const char *const *keys, size_t count, JsonNode **out)
+{
+	JsonNode *member;
+	size_t found = 0;
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		out[i] = NULL;
+
+	if (object == NULL || object->tag != JSON_OBJECT)
+		return 0;
+
+	if (object->children.index != NULL) {
+		for (i = 0; i < count; i++) {
+			out[i] = index_lookup(object->children.index, keys[i]);
+			if (out[i] != NULL)
+				found++;
+		}
+		return found;
+	}
+
+	json_foreach(member, object) {
+		for (i = 0; i < count; i++) {
+			if (out[i] == NULL && strcmp(member->key, keys[i]) == 0) {
+				out[i] = member;
+				found++;
+			}
+		}
+		if (found == count)
+			break;
+	}
+
+	return found;
+}
+
+void json_index(JsonNode *object)
+{
+	JsonIndex *index;
+	JsonNode *member;
+	size_t count = 0;
+	size_t slots = 2;
+	size_t size;
+	unsigned long failures;
+
+	if (object == NULL || object->tag != JSON_OBJECT || object->children.index != NULL)
+		return;
+
+	json_foreach(member, object)
+		count++;
+	while (slots < count * 2)
+		slots <<= 1;
+
+	size = sizeof(JsonIndex) + slots * sizeof(JsonNode *);
+	failures = pool_stats.failures;
+	if (object->arena_ != NULL)
+		index = (JsonIndex*) arena_alloc(object->arena_, size, ARENA_ALIGN);
+	else
+		index = (JsonIndex*) MALLOC(size);
+	/* The index is optional, lookups walk the members without it. */
+	if (index == NULL) {
+		pool_stats.failures = failures;
+		return;
+	}
+	memset(index, 0, size);
+	index->mask = slots - 1;
+
+	json_foreach(member, object) {
+		size_t i = index_hash(member->key) & index->mask;
+
+		while (index->slots[i] != NULL && strcmp(index->slots[i]->key, member->key) != 0)
+			i = (i + 1) & index->mask;
+		if (index->slots[i] == NULL)
+			index->slots[i] = member;
+	}
+	object->children.index = index;
+}
+
 JsonNode *json_first_child(const JsonNode *node)
 {
 	if (node != NULL && (node->tag == JSON_ARRAY || node->tag == JSON_OBJECT))
@@ -491,9 +1309,20 @@ JsonNode *json_first_child(const JsonNode *node)
 
 static JsonNode *mknode(JsonTag tag)
 {
-	JsonNode *ret = (JsonNode*) CALLOC(1, sizeof(JsonNode));
-	if (ret == NULL)
-		out_of_memory(); /*LCOV_EXCL_LINE*/
+	JsonNode *ret;
+
+	if (json_arena != NULL) {
+		ret = (JsonNode*) arena_alloc(json_arena, sizeof(JsonNode), ARENA_ALIGN);
+		if (ret == NULL)
+			return NULL;
+		memset(ret, 0, sizeof(JsonNode));
+		ret->arena_ = json_arena;
+		json_arena->roots++;
+	} else {
+		ret = node_alloc();
+		if (ret == NULL)
+			return NULL;
+	}
 	ret->tag = tag;
 	return ret;
 }
@@ -506,27 +1335,39 @@ JsonNode *json_mknull(void)
 JsonNode *json_mkbool(bool b)
 {
 	JsonNode *ret = mknode(JSON_BOOL);
-	ret->bool_ = b;
+	if (ret != NULL)
+		ret->bool_ = b;
 	return ret;
 }
 
 static JsonNode *mkstring(char *s)
 {
-	JsonNode *ret = mknode(JSON_STRING);
+	JsonNode *ret;
+
+	if (s == NULL)
+		return NULL;
+	ret = mknode(JSON_STRING);
+	if (ret == NULL) {
+		if (json_arena == NULL)
+			FREE(s);
+		return NULL;
+	}
 	ret->string_ = s;
 	return ret;
 }
 
 JsonNode *json_mkstring(const char *s)
 {
-	return mkstring(json_strdup(s));
+	return mkstring(json_strdup(json_arena, s));
 }
 
 JsonNode *json_mknumber(double n, int decimals)
 {
 	JsonNode *node = mknode(JSON_NUMBER);
-	node->number_ = n;
-	node->decimals_ = decimals;
+	if (node != NULL) {
+		node->number_ = n;
+		node->decimals_ = decimals;
+	}
 	return node;
 }
 
@@ -542,6 +1383,9 @@ JsonNode *json_mkobject(void)
 
 static void append_node(JsonNode *parent, JsonNode *child)
 {
+	if (child->arena_ != NULL)
+		child->arena_->roots--;
+	index_drop(parent);
 	child->parent = parent;
 	child->prev = parent->children.tail;
 	child->next = NULL;
@@ -555,6 +1399,9 @@ static void append_node(JsonNode *parent, JsonNode *child)
 
 static void prepend_node(JsonNode *parent, JsonNode *child)
 {
+	if (child->arena_ != NULL)
+		child->arena_->roots--;
+	index_drop(parent);
 	child->parent = parent;
 	child->prev = NULL;
 	child->next = parent->children.head;
@@ -574,6 +1421,10 @@ static void append_member(JsonNode *object, char *key, JsonNode *value)
 
 void json_append_element(JsonNode *array, JsonNode *element)
 {
+	if (array == NULL || element == NULL) {
+		json_delete(element);
+		return;
+	}
 	assert(array->tag == JSON_ARRAY);
 	assert(element->parent == NULL);
 
@@ -582,6 +1433,10 @@ void json_append_element(JsonNode *array, JsonNode *element)
 
 void json_prepend_element(JsonNode *array, JsonNode *element)
 {
+	if (array == NULL || element == NULL) {
+		json_delete(element);
+		return;
+	}
 	assert(array->tag == JSON_ARRAY);
 	assert(element->parent == NULL);
 
@@ -590,18 +1445,53 @@ void json_prepend_element(JsonNode *array, JsonNode *element)
 
 void json_append_member(JsonNode *object, const char *key, JsonNode *value)
 {
+	char *copy;
+
+	if (object == NULL || value == NULL) {
+		json_delete(value);
+		return;
+	}
+	assert(object->tag == JSON_OBJECT);
+	assert(value->parent == NULL);
+
+	copy = json_strdup(object->arena_, key);
+	if (copy == NULL) {
+		json_delete(value);
+		return;
+	}
+	append_member(object, copy, value);
+}
+
+void json_append_member_static(JsonNode *object, const char *key, JsonNode *value)
+{
+	if (object == NULL || value == NULL) {
+		json_delete(value);
+		return;
+	}
 	assert(object->tag == JSON_OBJECT);
 	assert(value->parent == NULL);
 
-	append_member(object, json_strdup(key), value);
+	value->static_key_ = true;
+	append_member(object, (char*) key, value);
 }
 
 void json_prepend_member(JsonNode *object, const char *key, JsonNode *value)
 {
+	char *copy;
+
+	if (object == NULL || value == NULL) {
+		json_delete(value);
+		return;
+	}
 	assert(object->tag == JSON_OBJECT);
 	assert(value->parent == NULL);
 
-	value->key = json_strdup(key);
+	copy = json_strdup(object->arena_, key);
+	if (copy == NULL) {
+		json_delete(value);
+		return;
+	}
+	value->key = copy;
 	prepend_node(object, value);
 }
 
@@ -610,6 +1500,7 @@ void json_remove_from_parent(JsonNode *node)
 	JsonNode *parent = node->parent;
 
 	if (parent != NULL) {
+		index_drop(parent);
 		if (node->prev != NULL)
 			node->prev->next = node->next;
 		else
@@ -619,13 +1510,17 @@ void json_remove_from_parent(JsonNode *node)
 		else
 			parent->children.tail = node->prev;
 
-		if(node->key != NULL) {
+		if(node->key != NULL && parent->arena_ == NULL && !node->static_key_) {
 			FREE(node->key);
 		}
+		if(node->arena_ != NULL) {
+			node->arena_->roots++;
+		}
 
 		node->parent = NULL;
 		node->prev = node->next = NULL;
 		node->key = NULL;
+		node->static_key_ = false;
 	}
 }
 
@@ -636,36 +1531,39 @@ static bool parse_value(const char **sp, JsonNode **out)
 	switch (*s) {
 		case 'n':
 			if (expect_literal(&s, "null")) {
-				if (out)
-					*out = json_mknull();
+				if (out && (*out = json_mknull()) == NULL)
+					goto out_of_memory;
 				*sp = s;
 				return true;
 			}
+			parse_fail(s, JSON_ERROR_TOKEN);
 			return false;
 
 		case 'f':
 			if (expect_literal(&s, "false")) {
-				if (out)
-					*out = json_mkbool(false);
+				if (out && (*out = json_mkbool(false)) == NULL)
+					goto out_of_memory;
 				*sp = s;
 				return true;
 			}
+			parse_fail(s, JSON_ERROR_TOKEN);
 			return false;
 
 		case 't':
 			if (expect_literal(&s, "true")) {
-				if (out)
-					*out = json_mkbool(true);
+				if (out && (*out = json_mkbool(true)) == NULL)
+					goto out_of_memory;
 				*sp = s;
 				return true;
 			}
+			parse_fail(s, JSON_ERROR_TOKEN);
 			return false;
 
 		case '"': {
 			char *str;
 			if (parse_string(&s, out ? &str : NULL)) {
-				if (out)
-					*out = mkstring(str);
+				if (out && (*out = mkstring(str)) == NULL)
+					goto out_of_memory;
 				*sp = s;
 				return true;
 			}
@@ -690,14 +1588,18 @@ static bool parse_value(const char **sp, JsonNode **out)
 			double num;
 			int decimals = 0;
 			if (parse_number(&s, out ? &num : NULL, &decimals)) {
-				if (out)
-					*out = json_mknumber(num, decimals);
+				if (out && (*out = json_mknumber(num, decimals)) == NULL)
+					goto out_of_memory;
 				*sp = s;
 				return true;
 			}
 			return false;
 		}
 	}
+
+out_of_memory:
+	parse_fail(*sp, JSON_ERROR_MEMORY);
+	return false;
 }
 
 static bool parse_array(const char **sp, JsonNode **out)
@@ -706,6 +1608,10 @@ static bool parse_array(const char **sp, JsonNode **out)
 	JsonNode *ret = out ? json_mkarray() : NULL;
 	JsonNode *element;
 
+	if (out && ret == NULL) {
+		parse_fail(s, JSON_ERROR_MEMORY);
+		return false;
+	}
 	if (*s++ != '[')
 		goto failure;
 	skip_space(&s);
@@ -728,8 +1634,11 @@ static bool parse_array(const char **sp, JsonNode **out)
 			goto success;
 		}
 
-		if (*s++ != ',')
+		if (*s != ',') {
+			parse_fail(s, JSON_ERROR_TOKEN);
 			goto failure;
+		}
+		s++;
 		skip_space(&s);
 	}
 
@@ -750,7 +1659,12 @@ static bool parse_object(const char **sp, JsonNode **out)
 	JsonNode *ret = out ? json_mkobject() : NULL;
 	char *key;
 	JsonNode *value;
+	size_t count = 0;
 
+	if (out && ret == NULL) {
+		parse_fail(s, JSON_ERROR_MEMORY);
+		return false;
+	}
 	if (*s++ != '{')
 		goto failure;
 	skip_space(&s);
@@ -765,8 +1679,11 @@ static bool parse_object(const char **sp, JsonNode **out)
 			goto failure;
 		skip_space(&s);
 
-		if (*s++ != ':')
+		if (*s != ':') {
+			parse_fail(s, JSON_ERROR_TOKEN);
 			goto failure_free_key;
+		}
+		s++;
 		skip_space(&s);
 
 		if (!parse_value(&s, out ? &value : NULL))
@@ -775,25 +1692,32 @@ static bool parse_object(const char **sp, JsonNode **out)
 
 		if (out)
 			append_member(ret, key, value);
+		count++;
 
 		if (*s == '}') {
 			s++;
 			goto success;
 		}
 
-		if (*s++ != ',')
+		if (*s != ',') {
+			parse_fail(s, JSON_ERROR_TOKEN);
 			goto failure;
+		}
+		s++;
 		skip_space(&s);
 	}
 
 success:
 	*sp = s;
-	if (out)
+	if (out) {
+		if (JSON_INDEX_MIN > 0 && count >= JSON_INDEX_MIN)
+			json_index(ret);
 		*out = ret;
+	}
 	return true;
 
 failure_free_key:
-	if (out)
+	if (out && json_arena == NULL)
 		FREE(key);
 failure:
 	json_delete(ret);
@@ -803,16 +1727,19 @@ failure:
 bool parse_string(const char **sp, char **out)
 {
 	const char *s = *sp;
+	const char *at = s; /* current character */
 	SB sb;
 	char throwaway_buffer[4];
 		/* enough space for a UTF-8 character */
 	char *b;
 
-	if (*s++ != '"')
+	if (*s++ != '"') {
+		parse_fail(at, JSON_ERROR_TOKEN);
 		return false;
+	}
 
 	if (out) {
-		sb_init(&sb);
+		sb_init(&sb, json_arena);
 		sb_need(&sb, 4);
 		b = sb.cur;
 	} else {
@@ -820,7 +1747,10 @@ bool parse_string(const char **sp, char **out)
 	}
 
 	while (*s != '"') {
-		unsigned char c = *s++;
+		unsigned char c;
+
+		at = s;
+		c = *s++;
 
 		/* Parse next character, and write it to b. */
 		if (c == '\\') {
@@ -904,12 +1834,18 @@ bool parse_string(const char **sp, char **out)
 	}
 	s++;
 
-	if (out)
+	if (out) {
 		*out = sb_finish(&sb);
+		if (*out == NULL) {
+			parse_fail(*sp, JSON_ERROR_MEMORY);
+			return false;
+		}
+	}
 	*sp = s;
 	return true;
 
 failed:
+	parse_fail(at, JSON_ERROR_STRING);
 	if (out)
 		sb_free(&sb);
 	return false;
@@ -925,24 +1861,40 @@ failed:
  *
  * This function takes the strict approach.
  */
+/* Powers of ten, which are exact doubles */
+static const double powers_of_10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Largest integer below which every integer is an exact double */
+#define EXACT_INTEGER_MAX	(1ULL << 53)
+
 bool parse_number(const char **sp, double *out, int *decimals)
 {
 	const char *s = *sp;
-	if(decimals != NULL) {
-		(*decimals) = 0;
-	}
+	uint64_t mantissa = 0;
+	int digits = 0; /* in mantissa, without leading zeros */
+	int fraction = 0;
+	bool negative = false;
+	bool exponent = false;
 
 	/* '-'? */
-	if (*s == '-')
+	if (*s == '-') {
+		negative = true;
 		s++;
+	}
 
 	/* (0 | [1-9][0-9]*) */
 	if (*s == '0') {
 		s++;
 	} else {
 		if (!is_digit(*s))
-			return false;
+			goto failed;
 		do {
+			if (digits < 19)
+				mantissa = mantissa * 10 + (*s - '0');
+			digits++;
 			s++;
 		} while (is_digit(*s));
 	}
@@ -951,32 +1903,56 @@ bool parse_number(const char **sp, double *out, int *decimals)
 	if (*s == '.') {
 		s++;
 		if (!is_digit(*s))
-			return false;
+			goto failed;
 		do {
+			if (digits > 0 || *s != '0')
+				digits++;
+			if (digits <= 19)
+				mantissa = mantissa * 10 + (*s - '0');
+			fraction++;
 			s++;
-			if(decimals != NULL) {
-				(*decimals)++;
-			}
 		} while (is_digit(*s));
 	}
 
 	/* ([Ee] [+-]? [0-9]+)? */
 	if (*s == 'E' || *s == 'e') {
+		exponent = true;
 		s++;
 		if (*s == '+' || *s == '-')
 			s++;
 		if (!is_digit(*s))
-			return false;
+			goto failed;
 		do {
 			s++;
 		} while (is_digit(*s));
 	}
 
-	if (out)
-		*out = strtod(*sp, NULL);
+	if (decimals != NULL)
+		*decimals = fraction;
+
+	if (out) {
+		/*
+		 * An exact mantissa divided by an exact power of ten is rounded
+		 * correctly, like strtod() does. Everything else goes to strtod().
+		 */
+		if (!exponent && digits <= 19 && mantissa <= EXACT_INTEGER_MAX
+		    && fraction <= 22) {
+			*out = (double) mantissa;
+			if (fraction > 0)
+				*out /= powers_of_10[fraction];
+			if (negative)
+				*out = -*out;
+		} else {
+			*out = strtod(*sp, NULL);
+		}
+	}
 
 	*sp = s;
 	return true;
+
+failed:
+	parse_fail(s, s == *sp ? JSON_ERROR_TOKEN : JSON_ERROR_NUMBER);
+	return false;
 }
 
 static void skip_space(const char **sp)
@@ -1262,6 +2238,54 @@ void emit_string(SB *out, const char *str)
 	out->cur = b;
 }
 
+/*
+ * Format num with decimals (at most 9) digits without floating point printf.
+ * Returns the length, or 0 if num is too large, not finite or too close to
+ * a rounding tie, to be formatted like printf("%.*f") would.
+ */
+static int format_fixed(char *buf, double num, int decimals)
+{
+	char digits[16];
+	bool negative = num < 0 || (num == 0 && 1 / num < 0);
+	double scaled, frac;
+	uint32_t value;
+	int len = 0, n = 0;
+
+	if (decimals < 0 || decimals > 9)
+		return 0;
+	scaled = (negative ? -num : num) * powers_of_10[decimals];
+	/* NaN fails the comparison, too */
+	if (!(scaled < 4294967295.0))
+		return 0;
+
+	/*
+	 * printf rounds the exact product, which differs from scaled by less
+	 * than 2^-21 below 2^32. Only a product close to a tie can round
+	 * differently.
+	 */
+	value = (uint32_t) scaled;
+	frac = scaled - value;
+	if (frac > 0.5 - 1e-5 && frac < 0.5 + 1e-5)
+		return 0;
+	if (frac > 0.5)
+		value++;
+
+	do {
+		digits[n++] = '0' + value % 10;
+		value /= 10;
+	} while (value != 0 || n <= decimals);
+
+	if (negative)
+		buf[len++] = '-';
+	while (n > 0) {
+		if (n == decimals)
+			buf[len++] = '.';
+		buf[len++] = digits[--n];
+	}
+	buf[len] = '\0';
+	return len;
+}
+
 static void emit_number(SB *out, double num, int decimals)
 {
 	/*
@@ -1271,10 +2295,22 @@ static void emit_number(SB *out, double num, int decimals)
 	 * like 0.3 -> 0.299999999999999988898 .
 	 */
 	char buf[64];
+	int len = format_fixed(buf, num, decimals);
+
+	if (len > 0) {
+		sb_put(out, buf, len);
+		return;
+	}
+
 #ifdef ESP8266
-	dtostrf(num, 0, decimals, buf);
+	/* dtostrf() does not know the size of buf. */
+	if (num > -1e40 && num < 1e40 && decimals <= 20)
+		dtostrf(num, 0, decimals, buf);
+	else
+		buf[0] = '\0';
 #else
-	sprintf(buf, "%.*f", decimals, num);
+	if (snprintf(buf, sizeof(buf), "%.*f", decimals, num) >= (int) sizeof(buf))
+		buf[0] = '\0';
 #endif
 
 	if (number_is_valid(buf))
@@ -1409,6 +2445,9 @@ bool json_check(const JsonNode *node, char errmsg[256])
 					problem("Array element's key is not NULL");
 				if (node->tag == JSON_OBJECT && child->key == NULL)
 					problem("Object member's key is NULL");
+				if (node->tag == JSON_OBJECT && node->children.index != NULL
+				    && index_lookup(node->children.index, child->key) == NULL)
+					problem("Object member is missing from the index");
 
 				if (!json_check(child, errmsg))
 					return false;
@@ -1451,16 +2490,89 @@ int json_find_string(JsonNode *object, const char *name, char **out) {
 	return 1;
 }
 
+unsigned long json_find_numbers(JsonNode *object, const char *const *keys, size_t count, double *out) {
+	JsonNode *nodes[32];
+	unsigned long found = 0;
+	size_t i;
+
+	if (count > 32)
+		count = 32;
+	json_find_members(object, keys, count, nodes);
+	for (i = 0; i < count; i++) {
+		if (nodes[i] != NULL && nodes[i]->tag == JSON_NUMBER) {
+			out[i] = nodes[i]->number_;
+			found |= 1UL << i;
+		}
+	}
+	return found;
+}
+
 void json_free(void *a) {
 	FREE(a);
 }
 
+JsonNode *json_copy(const JsonNode *node, bool share_keys) {
+	JsonNode *ret = NULL;
+	JsonNode *child = NULL;
+
+	if(node == NULL) {
+		return NULL;
+	}
+
+	switch(node->tag) {
+		case JSON_NULL:
+			return json_mknull();
+		case JSON_BOOL:
+			return json_mkbool(node->bool_);
+		case JSON_STRING:
+			return json_mkstring(node->string_);
+		case JSON_NUMBER:
+			return json_mknumber(node->number_, node->decimals_);
+		case JSON_ARRAY:
+			if((ret = json_mkarray()) == NULL) {
+				return NULL;
+			}
+			json_foreach(child, node) {
+				JsonNode *copy = json_copy(child, share_keys);
+				if(copy == NULL) {
+					json_delete(ret);
+					return NULL;
+				}
+				append_node(ret, copy);
+			}
+			return ret;
+		case JSON_OBJECT:
+			if((ret = json_mkobject()) == NULL) {
+				return NULL;
+			}
+			share_keys = share_keys && ret->arena_ != NULL;
+			json_foreach(child, node) {
+				JsonNode *copy = json_copy(child, share_keys);
+				char *key = child->key;
+				if(copy != NULL && !child->static_key_ && !share_keys) {
+					key = json_strdup(ret->arena_, child->key);
+				}
+				if(copy == NULL || key == NULL) {
+					json_delete(copy);
+					json_delete(ret);
+					return NULL;
+				}
+				copy->static_key_ = child->static_key_;
+				append_member(ret, key, copy);
+			}
+			if(node->children.index != NULL) {
+				json_index(ret);
+			}
+			return ret;
+		default:
+			return NULL;
+	}
+}
+
 int json_clone(struct JsonNode *a, struct JsonNode **b) {
 	if(*b != NULL) {
 		json_delete(*b);
 	}
-	char *out = json_stringify(a, NULL);
-	*b = json_decode(out);
-	json_free(out);
+	*b = json_copy(a, false);
 	return 0;
 }
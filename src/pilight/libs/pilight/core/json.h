@@ -37,7 +37,55 @@
 
 #define JsonTag			int
 
+/* Size of the blocks of an arena, see json_arena_begin() */
+#ifndef JSON_ARENA_SIZE
+#define JSON_ARENA_SIZE	384
+#endif
+
+/*
+ * Objects with at least this many members get a key index when they are
+ * decoded, 0 disables it. See json_index().
+ */
+#ifndef JSON_INDEX_MIN
+#define JSON_INDEX_MIN	4
+#endif
+
+/*
+ * Number of nodes outside of arenas and of arena blocks (of JSON_ARENA_SIZE)
+ * preallocated in static pools, 0 takes them from the heap. Larger blocks
+ * and requests of an exhausted pool are taken from the heap, too. See
+ * json_pool_stats().
+ */
+#ifndef JSON_POOL_NODES
+#define JSON_POOL_NODES	0
+#endif
+#ifndef JSON_POOL_BLOCKS
+#ifdef ESP8266
+#define JSON_POOL_BLOCKS	4
+#else
+#define JSON_POOL_BLOCKS	0
+#endif
+#endif
+
 typedef struct JsonNode JsonNode;
+typedef struct JsonArena JsonArena;
+typedef struct JsonIndex JsonIndex;
+
+typedef void (*JsonWriteCallback)(void *arg, const char *bytes, size_t count);
+
+#define JSON_ERROR_NONE		0
+#define JSON_ERROR_END		1	/* unexpected end of the input */
+#define JSON_ERROR_TOKEN	2	/* unexpected character */
+#define JSON_ERROR_STRING	3	/* invalid escape, control character or UTF-8 */
+#define JSON_ERROR_NUMBER	4
+#define JSON_ERROR_TRAILING	5	/* characters after the value */
+#define JSON_ERROR_LIMIT	6	/* valid, but deeper or larger than supported */
+#define JSON_ERROR_MEMORY	7	/* allocation failed */
+
+typedef struct JsonError {
+	size_t position; /* of the error in bytes */
+	int code;
+} JsonError;
 
 struct JsonNode
 {
@@ -63,26 +111,154 @@ struct JsonNode
 		/* JSON_OBJECT */
 		struct {
 			JsonNode *head, *tail;
+			JsonIndex *index; /* of the members of an object, may be NULL */
 		} children;
 	};
 	int decimals_;
+
+	/* key is borrowed, see json_append_member_static() */
+	bool static_key_;
+
+	/*
+	 * Arena of the node and its string, NULL for the heap. The keys of
+	 * members are allocated like their object.
+	 */
+	JsonArena *arena_;
 };
 
 /*** Encoding, decoding, and validation ***/
 
 JsonNode   *json_decode         (const char *json);
+/*
+ * Validate and decode json in a single pass. Returns NULL and, unless error
+ * is NULL, the position and code of the first invalid character on error.
+ */
+JsonNode   *json_parse          (const char *json, JsonError *error);
 char       *json_encode         (const JsonNode *node);
 char       *json_encode_string  (const char *str);
 char       *json_stringify      (const JsonNode *node, const char *space);
 void        json_delete         (JsonNode *node);
 
+/*
+ * Encode without allocating: into buf or in chunks to write. Both return the
+ * length of the whole encoding, buf holds it truncated, if that is not less
+ * than size. buf is always terminated, unless size is 0.
+ */
+size_t      json_encode_buffer  (const JsonNode *node, char *buf, size_t size);
+size_t      json_encode_writer  (const JsonNode *node, JsonWriteCallback write, void *arg);
+
 bool        json_validate       (const char *json);
 
+/*** Arena allocation ***/
+
+/*
+ * Until json_arena_end(), nodes, keys and strings are bump allocated from
+ * blocks of size bytes (JSON_ARENA_SIZE if 0), instead of one heap allocation
+ * each. json_delete() does not walk arena nodes, all blocks are released at
+ * once when the last node without parent is deleted. Heap nodes must not be
+ * added to arena nodes. Arenas may be nested.
+ */
+void json_arena_begin(size_t size);
+void json_arena_end(void);
+
+/*** Memory ***/
+
+/*
+ * A failed allocation does not end the program: constructors return NULL,
+ * appending NULL is ignored, parsing fails with JSON_ERROR_MEMORY and
+ * encoding returns NULL. Within a failed json_arena_begin() every allocation
+ * fails. failures counts them, so a message built meanwhile can be dropped.
+ */
+typedef struct JsonPoolStats {
+	size_t nodes;		/* outside of arenas, in use */
+	size_t nodes_peak;
+	size_t blocks;		/* of arenas, in use */
+	size_t blocks_peak;
+	unsigned long heap;	/* requests a pool could not serve */
+	unsigned long failures;	/* since the start */
+} JsonPoolStats;
+
+/* Fill stats, reset sets the peaks to the current use afterwards */
+void json_pool_stats(JsonPoolStats *stats, bool reset);
+
+/*** Pull parsing ***/
+
+#define JSON_EVENT_ERROR	-1	/* see JsonReader.error */
+#define JSON_EVENT_END		0	/* of the input */
+#define JSON_EVENT_VALUE	1	/* null, bool, string or number */
+#define JSON_EVENT_OBJECT	2
+#define JSON_EVENT_OBJECT_END	3
+#define JSON_EVENT_ARRAY	4
+#define JSON_EVENT_ARRAY_END	5
+
+/* Nesting limit of a JsonReader */
+#define JSON_READER_DEPTH	32
+
+typedef struct JsonReader {
+	const char *start;
+	const char *pos;
+	unsigned long objects; /* bit i is set, if level i + 1 is an object */
+	int depth;
+	bool more; /* a value was read on the current level */
+	JsonError error;
+} JsonReader;
+
+/*
+ * Event of json_read(). Keys and strings point into the input, they are
+ * neither unescaped nor terminated, see json_unescape().
+ */
+typedef struct JsonToken {
+	const char *key; /* of a member, NULL otherwise */
+	size_t key_length;
+	JsonTag tag; /* of a value */
+	bool bool_;
+	double number_;
+	int decimals_;
+	const char *string_;
+	size_t length;
+} JsonToken;
+
+void json_reader_init(JsonReader *reader, const char *json);
+
+/*
+ * Validate json up to the next value or bracket without building nodes.
+ * Returns the JSON_EVENT_* and fills token.
+ */
+int json_read(JsonReader *reader, JsonToken *token);
+
+/*
+ * Unescape length bytes of a key or string of a JsonToken into buf. Returns
+ * the length of the whole string; buf is truncated and terminated like by
+ * json_encode_buffer().
+ */
+size_t json_unescape(const char *str, size_t length, char *buf, size_t size);
+
+/*
+ * Read a flat object, whose members are no objects or arrays, without
+ * allocating: the object is nodes[0], its members follow, their keys and
+ * strings are unescaped into buf. The result only supports lookups and
+ * must not be deleted. Returns NULL on error, which is JSON_ERROR_LIMIT if
+ * json is valid so far, but no flat object or does not fit.
+ */
+JsonNode   *json_parse_flat     (const char *json, JsonNode *nodes, size_t count, char *buf, size_t size, JsonError *error);
+
 /*** Lookup and traversal ***/
 
 JsonNode   *json_find_element   (JsonNode *array, int index);
 JsonNode   *json_find_member    (JsonNode *object, const char *key);
 
+/*
+ * Look up count keys in a single walk over the members of object. out[i] is
+ * the first member named keys[i] or NULL. Returns the number of keys found.
+ */
+size_t      json_find_members   (JsonNode *object, const char *const *keys, size_t count, JsonNode **out);
+
+/*
+ * Hash the keys of object, so json_find_member() does not compare them one
+ * by one. The index is dropped when members are added or removed.
+ */
+void        json_index          (JsonNode *object);
+
 JsonNode   *json_first_child    (const JsonNode *node);
 
 #define json_foreach(i, object_or_array)            \
@@ -102,6 +278,11 @@ JsonNode *json_mkobject(void);
 void json_append_element(JsonNode *array, JsonNode *element);
 void json_prepend_element(JsonNode *array, JsonNode *element);
 void json_append_member(JsonNode *object, const char *key, JsonNode *value);
+/*
+ * Append value without copying key, which must be a string constant or
+ * otherwise outlive value. It is not freed with value.
+ */
+void json_append_member_static(JsonNode *object, const char *key, JsonNode *value);
 void json_prepend_member(JsonNode *object, const char *key, JsonNode *value);
 
 void json_remove_from_parent(JsonNode *node);
@@ -122,6 +303,21 @@ int json_find_bool(JsonNode *object, const char *name, double *out);
 int json_find_number(JsonNode *object, const char *name, double *out);
 int json_find_string(JsonNode *object, const char *name, char **out);
 
+/*
+ * Like json_find_number() for count (at most 32) keys. Returns a mask with
+ * bit i set, if keys[i] is a number, which is stored in out[i].
+ */
+unsigned long json_find_numbers(JsonNode *object, const char *const *keys, size_t count, double *out);
+
+/*
+ * Deep copy of node, allocated like new nodes, i.e. from the current arena,
+ * if any. With share_keys, members of an arena copy borrow the keys of node,
+ * which must outlive the copy. Other copies own their keys, except those
+ * appended with json_append_member_static().
+ */
+JsonNode *json_copy(const JsonNode *node, bool share_keys);
+
+/* Replace *b by json_copy(a, false) */
 int json_clone(struct JsonNode *a, struct JsonNode **b);
 
 bool utf8_validate(const char *s);
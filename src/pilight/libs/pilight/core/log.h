@@ -31,11 +31,15 @@
 #define LOG_STACK               255
 
 #include <stdio.h>
+
+/* non-zero suppresses logprintf(), e.g. while errors are reported otherwise */
+extern int log_mute;
+
 #ifdef ESP8266
 extern int ets_uart_printf(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
-#define logprintf(prio, args...) {ets_uart_printf("pilight(%d): ", prio);ets_uart_printf(args);ets_uart_printf("\n");}
+#define logprintf(prio, args...) if(!log_mute) {ets_uart_printf("pilight(%d): ", prio);ets_uart_printf(args);ets_uart_printf("\n");}
 #else
-#define logprintf(prio, args...) {printf("pilight(%d): ", prio);printf(args);printf("\n");}
+#define logprintf(prio, args...) if(!log_mute) {printf("pilight(%d): ", prio);printf(args);printf("\n");}
 #endif
 
 #endif
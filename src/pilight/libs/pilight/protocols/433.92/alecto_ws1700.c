@@ -100,10 +100,10 @@ static void parseCode(void) {
 	humidity += humi_offset;
 
 	alecto_ws1700->message = json_mkobject();
-	json_append_member(alecto_ws1700->message, "id", json_mknumber(id, 0));
-	json_append_member(alecto_ws1700->message, "temperature", json_mknumber(temperature, 1));
-	json_append_member(alecto_ws1700->message, "humidity", json_mknumber(humidity, 1));
-	json_append_member(alecto_ws1700->message, "battery", json_mknumber(battery, 0));
+	json_append_member_static(alecto_ws1700->message, "id", json_mknumber(id, 0));
+	json_append_member_static(alecto_ws1700->message, "temperature", json_mknumber(temperature, 1));
+	json_append_member_static(alecto_ws1700->message, "humidity", json_mknumber(humidity, 1));
+	json_append_member_static(alecto_ws1700->message, "battery", json_mknumber(battery, 0));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
@@ -87,8 +87,8 @@ static void parseCode(void) {
 	temperature += temp_offset;
 
 	alecto_wsd17->message = json_mkobject();
-	json_append_member(alecto_wsd17->message, "id", json_mknumber(id, 0));
-	json_append_member(alecto_wsd17->message, "temperature", json_mknumber(temperature/10, 1));
+	json_append_member_static(alecto_wsd17->message, "id", json_mknumber(id, 0));
+	json_append_member_static(alecto_wsd17->message, "temperature", json_mknumber(temperature/10, 1));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
@@ -27,6 +27,7 @@
 #include "../../core/log.h"
 #include "../protocol.h"
 #include "../../core/binary.h"
+#include "../../core/checksum.h"
 #include "../../core/gc.h"
 #include "alecto_wx500.h"
 //
@@ -66,9 +67,9 @@ static void parseCode(void) {
 	double humidity = 0.0, temperature = 0.0;
 	int winddir = 0, windavg = 0, windgust = 0;
 	int /*rain = 0, */battery = 0;
-	int n0 = 0, n1 = 0, n2 = 0, n3 = 0;
-	int n4 = 0, n5 = 0, n6 = 0, n7 = 0, n8 = 0;
-	int checksum = 1;
+	int n2 = 0, n3 = 0, n8 = 0;
+	int checksum = 1, sum = 0;
+	uint8_t bytes[RAW_LENGTH/16+1];
 
 	if(alecto_wx500->rawlen>RAW_LENGTH) {
 		logprintf(LOG_ERR, "alecto_wx500: parsecode - invalid parameter passed %d", alecto_wx500->rawlen);
@@ -84,14 +85,11 @@ static void parseCode(void) {
 	}
 
 	n8=binToDec(binary, 32, 35);
-	n7=binToDec(binary, 28, 31);
-	n6=binToDec(binary, 24, 27);
-	n5=binToDec(binary, 20, 23);
-	n4=binToDec(binary, 16, 19);
 	n3=binToDec(binary, 12, 15);
 	n2=binToDec(binary, 8, 11);
-	n1=binToDec(binary, 4, 7);
-	n0=binToDec(binary, 0, 3);
+
+	bits_to_bytes_rev(binary, 0, 31, bytes);
+	sum = add_nibbles(bytes, 8);
 
 	struct settings_t *tmp = settings;
 	while(tmp) {
@@ -105,7 +103,7 @@ static void parseCode(void) {
 
 	if((n2 & 0x6) != 0x6) {
 		type = 0x1;
-		checksum = (0xf-n0-n1-n2-n3-n4-n5-n6-n7) & 0xf;
+		checksum = (0xf-sum) & 0xf;
 		if(n8 != checksum) {
 			type=0x5;
 			return;
@@ -113,7 +111,7 @@ static void parseCode(void) {
 	//Wind average * 0.2
 	} else if(n3 == 0x1) {
 		type = 0x2;
-		checksum = (0xf-n0-n1-n2-n3-n4-n5-n6-n7) & 0xf;
+		checksum = (0xf-sum) & 0xf;
 		if(n8 != checksum){
 			type=0x5;
 			return;
@@ -121,7 +119,7 @@ static void parseCode(void) {
 	//Wind direction & gust
 	} else if((n3 & 0x7) == 0x7) {
 		type = 0x3;
-		checksum = (0xf-n0-n1-n2-n3-n4-n5-n6-n7) & 0xf;
+		checksum = (0xf-sum) & 0xf;
 		if(n8 != checksum) {
 			type=0x5;
 			return;
@@ -129,7 +127,7 @@ static void parseCode(void) {
 	//Rain
 	} else if(n3 == 0x3)	{
 		type = 0x4;
-		checksum = (0x7+n0+n1+n2+n3+n4+n5+n6+n7) & 0xf;
+		checksum = (0x7+sum) & 0xf;
 		if(n8 != checksum){
 			type = 0x5;
 			return;
@@ -151,19 +149,19 @@ static void parseCode(void) {
 			temperature += temp_offset;
 			humidity += humi_offset;
 
-			json_append_member(alecto_wx500->message, "id", json_mknumber(id, 0));
-			json_append_member(alecto_wx500->message, "temperature", json_mknumber(temperature, 1));
-			json_append_member(alecto_wx500->message, "humidity", json_mknumber(humidity, 1));
-			json_append_member(alecto_wx500->message, "battery", json_mknumber(battery, 0));
+			json_append_member_static(alecto_wx500->message, "id", json_mknumber(id, 0));
+			json_append_member_static(alecto_wx500->message, "temperature", json_mknumber(temperature, 1));
+			json_append_member_static(alecto_wx500->message, "humidity", json_mknumber(humidity, 1));
+			json_append_member_static(alecto_wx500->message, "battery", json_mknumber(battery, 0));
 		break;
 		case 2:
 			id = binToDec(binary, 0, 7);
 			windavg = binToDec(binary, 24, 31) * 2;
 			battery = !binary[8];
 
-			json_append_member(alecto_wx500->message, "id", json_mknumber(id, 0));
-			json_append_member(alecto_wx500->message, "windavg", json_mknumber((double)windavg/10, 1));
-			json_append_member(alecto_wx500->message, "battery", json_mknumber(battery, 0));
+			json_append_member_static(alecto_wx500->message, "id", json_mknumber(id, 0));
+			json_append_member_static(alecto_wx500->message, "windavg", json_mknumber((double)windavg/10, 1));
+			json_append_member_static(alecto_wx500->message, "battery", json_mknumber(battery, 0));
 		break;
 		case 3:
 			id = binToDec(binary, 0, 7);
@@ -171,18 +169,18 @@ static void parseCode(void) {
 			windgust = binToDec(binary, 24, 31) * 2;
 			battery = !binary[8];
 
-			json_append_member(alecto_wx500->message, "id", json_mknumber(id, 0));
-			json_append_member(alecto_wx500->message, "winddir", json_mknumber((double)winddir, 0));
-			json_append_member(alecto_wx500->message, "windgust", json_mknumber((double)windgust/10, 1));
-			json_append_member(alecto_wx500->message, "battery", json_mknumber(battery, 0));
+			json_append_member_static(alecto_wx500->message, "id", json_mknumber(id, 0));
+			json_append_member_static(alecto_wx500->message, "winddir", json_mknumber((double)winddir, 0));
+			json_append_member_static(alecto_wx500->message, "windgust", json_mknumber((double)windgust/10, 1));
+			json_append_member_static(alecto_wx500->message, "battery", json_mknumber(battery, 0));
 		break;
 		case 4:
 			id = binToDec(binary, 0, 7);
 			/*rain = binToDec(binary, 16, 30) * 5;*/
 			battery = !binary[8];
-			//json_append_member(alecto_wx500->message, "rain", json_mknumber((double)rain/10, 1));
-			json_append_member(alecto_wx500->message, "id", json_mknumber(id, 0));
-			json_append_member(alecto_wx500->message, "battery", json_mknumber(battery, 0));
+			//json_append_member_static(alecto_wx500->message, "rain", json_mknumber((double)rain/10, 1));
+			json_append_member_static(alecto_wx500->message, "id", json_mknumber(id, 0));
+			json_append_member_static(alecto_wx500->message, "battery", json_mknumber(battery, 0));
 		break;
 		default:
 			type=0x5;
@@ -274,6 +272,7 @@ void alectoWX500Init(void) {
 	alecto_wx500->maxrawlen = RAW_LENGTH;
 	alecto_wx500->maxgaplen = MAX_PULSE_LENGTH*PULSE_DIV;
 	alecto_wx500->mingaplen = MIN_PULSE_LENGTH*PULSE_DIV;
+	alecto_wx500->checksum = 1;
 
 	options_add(&alecto_wx500->options, "t", "temperature", OPTION_HAS_VALUE, DEVICES_VALUE, JSON_NUMBER, NULL, "^[0-9]{1,3}$");
 	options_add(&alecto_wx500->options, "i", "id", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "[0-9]");
@@ -52,17 +52,17 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all) {
 	arctech_contact->message = json_mkobject();
-	json_append_member(arctech_contact->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_contact->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(arctech_contact->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_contact->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_contact->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_contact->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_contact->message, "state", json_mkstring("opened"));
+		json_append_member_static(arctech_contact->message, "state", json_mkstring("opened"));
 	} else {
-		json_append_member(arctech_contact->message, "state", json_mkstring("closed"));
+		json_append_member_static(arctech_contact->message, "state", json_mkstring("closed"));
 	}
 }
 
@@ -53,25 +53,25 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all, int dimlevel, int learn) {
 	arctech_dimmer->message = json_mkobject();
-	json_append_member(arctech_dimmer->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_dimmer->message, "id", json_mknumber(id, 0));
 
 	if(all == 1) {
-		json_append_member(arctech_dimmer->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_dimmer->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_dimmer->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_dimmer->message, "unit", json_mknumber(unit, 0));
 	}
 
 	/*if(dimlevel == 0) {
 		state = 0;
 	} else */if(dimlevel >= 0) {
 		state = 1;
-		json_append_member(arctech_dimmer->message, "dimlevel", json_mknumber(dimlevel, 0));
+		json_append_member_static(arctech_dimmer->message, "dimlevel", json_mknumber(dimlevel, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_dimmer->message, "state", json_mkstring("on"));
+		json_append_member_static(arctech_dimmer->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(arctech_dimmer->message, "state", json_mkstring("off"));
+		json_append_member_static(arctech_dimmer->message, "state", json_mkstring("off"));
 	}
 
 	if(learn == 1) {
@@ -239,27 +239,32 @@ static int createCode(struct JsonNode *code) {
 	int learn = -1;
 	int max = 15;
 	int min = 0;
-	double itmp = -1;
-
-	if(json_find_number(code, "dimlevel-maximum", &itmp) == 0)
-		max = (int)round(itmp);
-	if(json_find_number(code, "dimlevel-minimum", &itmp) == 0)
-		min = (int)round(itmp);
-
-	if(json_find_number(code, "id", &itmp) == 0)
-		id = (int)round(itmp);
-	if(json_find_number(code, "unit", &itmp) == 0)
-		unit = (int)round(itmp);
-	if(json_find_number(code, "dimlevel", &itmp) == 0)
-		dimlevel = (int)round(itmp);
-	if(json_find_number(code, "all", &itmp) == 0)
-		all = (int)round(itmp);
-	if(json_find_number(code, "learn", &itmp) == 0)
+	enum { ARG_MAX, ARG_MIN, ARG_ID, ARG_UNIT, ARG_DIMLEVEL, ARG_ALL, ARG_LEARN, ARG_OFF, ARG_ON, ARGS };
+	static const char *const args[ARGS] = {
+		"dimlevel-maximum", "dimlevel-minimum", "id", "unit", "dimlevel", "all", "learn", "off", "on"
+	};
+	double values[ARGS];
+	unsigned long found = json_find_numbers(code, args, ARGS, values);
+
+	if(found & (1UL << ARG_MAX))
+		max = (int)round(values[ARG_MAX]);
+	if(found & (1UL << ARG_MIN))
+		min = (int)round(values[ARG_MIN]);
+
+	if(found & (1UL << ARG_ID))
+		id = (int)round(values[ARG_ID]);
+	if(found & (1UL << ARG_UNIT))
+		unit = (int)round(values[ARG_UNIT]);
+	if(found & (1UL << ARG_DIMLEVEL))
+		dimlevel = (int)round(values[ARG_DIMLEVEL]);
+	if(found & (1UL << ARG_ALL))
+		all = (int)round(values[ARG_ALL]);
+	if(found & (1UL << ARG_LEARN))
 		learn = 1;
 
-	if(json_find_number(code, "off", &itmp) == 0)
+	if(found & (1UL << ARG_OFF))
 		state=0;
-	else if(json_find_number(code, "on", &itmp) == 0)
+	else if(found & (1UL << ARG_ON))
 		state=1;
 
 	if(all > 0 && learn > -1) {
@@ -49,17 +49,17 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all) {
 	arctech_dusk->message = json_mkobject();
-	json_append_member(arctech_dusk->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_dusk->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(arctech_dusk->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_dusk->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_dusk->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_dusk->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_dusk->message, "state", json_mkstring("dusk"));
+		json_append_member_static(arctech_dusk->message, "state", json_mkstring("dusk"));
 	} else {
-		json_append_member(arctech_dusk->message, "state", json_mkstring("dawn"));
+		json_append_member_static(arctech_dusk->message, "state", json_mkstring("dawn"));
 	}
 }
 
@@ -49,17 +49,17 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all) {
 	arctech_motion->message = json_mkobject();
-	json_append_member(arctech_motion->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_motion->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(arctech_motion->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_motion->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_motion->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_motion->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_motion->message, "state", json_mkstring("on"));
+		json_append_member_static(arctech_motion->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(arctech_motion->message, "state", json_mkstring("off"));
+		json_append_member_static(arctech_motion->message, "state", json_mkstring("off"));
 	}
 }
 
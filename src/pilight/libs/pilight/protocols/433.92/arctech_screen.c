@@ -52,17 +52,17 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all, int learn) {
 	arctech_screen->message = json_mkobject();
-	json_append_member(arctech_screen->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_screen->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(arctech_screen->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_screen->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_screen->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_screen->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_screen->message, "state", json_mkstring("up"));
+		json_append_member_static(arctech_screen->message, "state", json_mkstring("up"));
 	} else {
-		json_append_member(arctech_screen->message, "state", json_mkstring("down"));
+		json_append_member_static(arctech_screen->message, "state", json_mkstring("down"));
 	}
 
 	if(learn == 1) {
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state) {
 	arctech_screen_old->message = json_mkobject();
-	json_append_member(arctech_screen_old->message, "id", json_mknumber(id, 0));
-	json_append_member(arctech_screen_old->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(arctech_screen_old->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_screen_old->message, "unit", json_mknumber(unit, 0));
 	if(state == 1)
-		json_append_member(arctech_screen_old->message, "state", json_mkstring("up"));
+		json_append_member_static(arctech_screen_old->message, "state", json_mkstring("up"));
 	else
-		json_append_member(arctech_screen_old->message, "state", json_mkstring("down"));
+		json_append_member_static(arctech_screen_old->message, "state", json_mkstring("down"));
 }
 
 static void parseCode(void) {
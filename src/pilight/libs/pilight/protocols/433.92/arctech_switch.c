@@ -53,18 +53,18 @@ static int validate(void) {
 static void createMessage(int id, int unit, int state, int all, int learn) {
 	arctech_switch->message = json_mkobject();
 
-	json_append_member(arctech_switch->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_switch->message, "id", json_mknumber(id, 0));
 
 	if(all == 1) {
-		json_append_member(arctech_switch->message, "all", json_mknumber(all, 0));
+		json_append_member_static(arctech_switch->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(arctech_switch->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(arctech_switch->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(arctech_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(arctech_switch->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(arctech_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(arctech_switch->message, "state", json_mkstring("off"));
 	}
 
 	if(learn == 1) {
@@ -179,19 +179,22 @@ static int createCode(struct JsonNode *code) {
 	int state = -1;
 	int all = 0;
 	int learn = -1;
-	double itmp = -1;
-
-	if(json_find_number(code, "id", &itmp) == 0)
-		id = (int)round(itmp);
-	if(json_find_number(code, "unit", &itmp) == 0)
-		unit = (int)round(itmp);
-	if(json_find_number(code, "all", &itmp)	== 0)
-		all = (int)round(itmp);
-	if(json_find_number(code, "off", &itmp) == 0)
+	enum { ARG_ID, ARG_UNIT, ARG_ALL, ARG_OFF, ARG_ON, ARG_LEARN, ARGS };
+	static const char *const args[ARGS] = { "id", "unit", "all", "off", "on", "learn" };
+	double values[ARGS];
+	unsigned long found = json_find_numbers(code, args, ARGS, values);
+
+	if(found & (1UL << ARG_ID))
+		id = (int)round(values[ARG_ID]);
+	if(found & (1UL << ARG_UNIT))
+		unit = (int)round(values[ARG_UNIT]);
+	if(found & (1UL << ARG_ALL))
+		all = (int)round(values[ARG_ALL]);
+	if(found & (1UL << ARG_OFF))
 		state=0;
-	else if(json_find_number(code, "on", &itmp) == 0)
+	else if(found & (1UL << ARG_ON))
 		state=1;
-	if(json_find_number(code, "learn", &itmp) == 0)
+	if(found & (1UL << ARG_LEARN))
 		learn = 1;
 
 	if(all > 0 && learn > -1) {
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state) {
 	arctech_switch_old->message = json_mkobject();
-	json_append_member(arctech_switch_old->message, "id", json_mknumber(id, 0));
-	json_append_member(arctech_switch_old->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(arctech_switch_old->message, "id", json_mknumber(id, 0));
+	json_append_member_static(arctech_switch_old->message, "unit", json_mknumber(unit, 0));
 	if(state == 1)
-		json_append_member(arctech_switch_old->message, "state", json_mkstring("on"));
+		json_append_member_static(arctech_switch_old->message, "state", json_mkstring("on"));
 	else
-		json_append_member(arctech_switch_old->message, "state", json_mkstring("off"));
+		json_append_member_static(arctech_switch_old->message, "state", json_mkstring("off"));
 }
 
 static void parseCode(void) {
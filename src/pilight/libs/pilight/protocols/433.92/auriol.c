@@ -91,10 +91,10 @@ static void parseCode(void) {
 
 	if(channel != 4) {
 		auriol->message = json_mkobject();
-		json_append_member(auriol->message, "id", json_mknumber(id, 0));
-		json_append_member(auriol->message, "temperature", json_mknumber(temperature, 1));
-		json_append_member(auriol->message, "battery", json_mknumber(battery, 0));
-		json_append_member(auriol->message, "channel", json_mknumber(channel, 0));
+		json_append_member_static(auriol->message, "id", json_mknumber(id, 0));
+		json_append_member_static(auriol->message, "temperature", json_mknumber(temperature, 1));
+		json_append_member_static(auriol->message, "battery", json_mknumber(battery, 0));
+		json_append_member_static(auriol->message, "channel", json_mknumber(channel, 0));
 	}
 }
 
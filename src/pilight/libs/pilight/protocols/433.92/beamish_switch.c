@@ -52,17 +52,17 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all) {
 	beamish_switch->message = json_mkobject();
-	json_append_member(beamish_switch->message, "id", json_mknumber(id, 0));
+	json_append_member_static(beamish_switch->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(beamish_switch->message, "all", json_mknumber(1, 0));
+		json_append_member_static(beamish_switch->message, "all", json_mknumber(1, 0));
 	} else {
-		json_append_member(beamish_switch->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(beamish_switch->message, "unit", json_mknumber(unit, 0));
 	}
 	if(state == 0) {
-		json_append_member(beamish_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(beamish_switch->message, "state", json_mkstring("off"));
 	}
 	if(state == 1) {
-		json_append_member(beamish_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(beamish_switch->message, "state", json_mkstring("on"));
 	}
 }
 
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(const char *id, int unit, int state) {
 	clarus_switch->message = json_mkobject();
-	json_append_member(clarus_switch->message, "id", json_mkstring(id));
-	json_append_member(clarus_switch->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(clarus_switch->message, "id", json_mkstring(id));
+	json_append_member_static(clarus_switch->message, "unit", json_mknumber(unit, 0));
 	if(state == 2)
-		json_append_member(clarus_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(clarus_switch->message, "state", json_mkstring("on"));
 	else
-		json_append_member(clarus_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(clarus_switch->message, "state", json_mkstring("off"));
 }
 
 static void parseCode(void) {
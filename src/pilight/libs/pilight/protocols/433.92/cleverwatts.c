@@ -49,16 +49,16 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state, int all) {
 	cleverwatts->message = json_mkobject();
-	json_append_member(cleverwatts->message, "id", json_mknumber(id, 0));
+	json_append_member_static(cleverwatts->message, "id", json_mknumber(id, 0));
 	if(all == 0) {
-		json_append_member(cleverwatts->message, "all", json_mknumber(1, 0));
+		json_append_member_static(cleverwatts->message, "all", json_mknumber(1, 0));
 	} else {
-		json_append_member(cleverwatts->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(cleverwatts->message, "unit", json_mknumber(unit, 0));
 	}
 	if(state == 0)
-		json_append_member(cleverwatts->message, "state", json_mkstring("on"));
+		json_append_member_static(cleverwatts->message, "state", json_mkstring("on"));
 	else
-		json_append_member(cleverwatts->message, "state", json_mkstring("off"));
+		json_append_member_static(cleverwatts->message, "state", json_mkstring("off"));
 }
 
 static void parseCode(void) {
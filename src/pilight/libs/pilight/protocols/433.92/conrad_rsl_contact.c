@@ -48,11 +48,11 @@ static int validate(void) {
 
 static void createMessage(int id, int state) {
 	conrad_rsl_contact->message = json_mkobject();
-	json_append_member(conrad_rsl_contact->message, "id", json_mknumber(id, 0));
+	json_append_member_static(conrad_rsl_contact->message, "id", json_mknumber(id, 0));
 	if(state == 1) {
-		json_append_member(conrad_rsl_contact->message, "state", json_mkstring("opened"));
+		json_append_member_static(conrad_rsl_contact->message, "state", json_mkstring("opened"));
 	} else {
-		json_append_member(conrad_rsl_contact->message, "state", json_mkstring("closed"));
+		json_append_member_static(conrad_rsl_contact->message, "state", json_mkstring("closed"));
 	}
 }
 
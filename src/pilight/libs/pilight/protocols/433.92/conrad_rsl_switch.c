@@ -55,15 +55,15 @@ static void createMessage(int id, int unit, int state, int learn) {
 	conrad_rsl_switch->message = json_mkobject();
 
 	if(id == 4) {
-		json_append_member(conrad_rsl_switch->message, "all", json_mknumber(1, 0));
+		json_append_member_static(conrad_rsl_switch->message, "all", json_mknumber(1, 0));
 	} else {
-		json_append_member(conrad_rsl_switch->message, "id", json_mknumber(id+1, 0));
+		json_append_member_static(conrad_rsl_switch->message, "id", json_mknumber(id+1, 0));
 	}
-	json_append_member(conrad_rsl_switch->message, "unit", json_mknumber(unit+1, 0));
+	json_append_member_static(conrad_rsl_switch->message, "unit", json_mknumber(unit+1, 0));
 	if(state == 1) {
-		json_append_member(conrad_rsl_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(conrad_rsl_switch->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(conrad_rsl_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(conrad_rsl_switch->message, "state", json_mkstring("off"));
 	}
 	if(learn == 1) {
 		conrad_rsl_switch->txrpt = LEARN_REPEATS;
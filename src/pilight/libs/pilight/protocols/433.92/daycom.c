@@ -49,13 +49,13 @@ static int validate(void) {
 
 static void createMessage(int id, int systemcode, int unit, int state) {
 	daycom->message = json_mkobject();
-	json_append_member(daycom->message, "id", json_mknumber(id, 0));
-	json_append_member(daycom->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(daycom->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(daycom->message, "id", json_mknumber(id, 0));
+	json_append_member_static(daycom->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(daycom->message, "unit", json_mknumber(unit, 0));
 	if(state == 0) {
-		json_append_member(daycom->message, "state", json_mkstring("on"));
+		json_append_member_static(daycom->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(daycom->message, "state", json_mkstring("off"));
+		json_append_member_static(daycom->message, "state", json_mkstring("off"));
 	}
 }
 
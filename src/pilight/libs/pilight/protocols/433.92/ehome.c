@@ -49,11 +49,11 @@ static int validate(void) {
 
 static void createMessage(int id, int state) {
 	ehome->message = json_mkobject();
-	json_append_member(ehome->message, "id", json_mknumber(id, 0));
+	json_append_member_static(ehome->message, "id", json_mknumber(id, 0));
 	if(state == 1) {
-		json_append_member(ehome->message, "state", json_mkstring("on"));
+		json_append_member_static(ehome->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(ehome->message, "state", json_mkstring("off"));
+		json_append_member_static(ehome->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -58,19 +58,19 @@ static int validate(void) {
 static void createMessage(unsigned long long systemcode, int unitcode, int state, int group) {
 	elro_300_switch->message = json_mkobject();
 	//aka address
-	json_append_member(elro_300_switch->message, "systemcode", json_mknumber((double)systemcode, 0));
+	json_append_member_static(elro_300_switch->message, "systemcode", json_mknumber((double)systemcode, 0));
 	//toggle all or just one unit
 	if(group == 1) {
-	    json_append_member(elro_300_switch->message, "all", json_mknumber(group, 0));
+	    json_append_member_static(elro_300_switch->message, "all", json_mknumber(group, 0));
 	} else {
-	    json_append_member(elro_300_switch->message, "unitcode", json_mknumber(unitcode, 0));
+	    json_append_member_static(elro_300_switch->message, "unitcode", json_mknumber(unitcode, 0));
 	}
 	//aka command
 	if(state == 1) {
-		json_append_member(elro_300_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(elro_300_switch->message, "state", json_mkstring("on"));
 	}
 	else if(state == 2) {
-		json_append_member(elro_300_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(elro_300_switch->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int unitcode, int state) {
 	elro_800_switch->message = json_mkobject();
-	json_append_member(elro_800_switch->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(elro_800_switch->message, "unitcode", json_mknumber(unitcode, 0));
+	json_append_member_static(elro_800_switch->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(elro_800_switch->message, "unitcode", json_mknumber(unitcode, 0));
 	if(state == 0) {
-		json_append_member(elro_800_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(elro_800_switch->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(elro_800_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(elro_800_switch->message, "state", json_mkstring("off"));
 	}
 }
 
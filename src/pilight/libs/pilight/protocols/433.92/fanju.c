@@ -50,6 +50,7 @@
 #include "../../core/log.h"
 #include "../protocol.h"
 #include "../../core/binary.h"
+#include "../../core/checksum.h"
 #include "../../core/gc.h"
 #include "fanju.h"
 
@@ -70,6 +71,7 @@ typedef struct settings_t {
 } settings_t;
 
 static struct settings_t *settings = NULL;
+static lfsr4_t lfsr;
 
 static int validate(void) {
 	if(fanju->rawlen == RAW_LENGTH) {
@@ -84,7 +86,8 @@ static int validate(void) {
 
 static void parseCode(void) {
 	int i=0, x=0, binary[MSG_LENGTH];
-	int binary_cpy[MSG_LENGTH], mask=0, checksum_calc=0, bit=0;
+	int binary_cpy[MSG_LENGTH], checksum_calc=0;
+	uint8_t bytes[MSG_LENGTH/8+1];
 	int header=0, id=0, channel=0, battery=0, checksum=0;
 	double temp_offset=0.0, temperature=0.0, temp_fahrenheit=0.0, temp_celsius=0.0;
 	double humi_offset=0.0, humidity=0.0;
@@ -134,18 +137,8 @@ static void parseCode(void) {
 		binary_cpy[x++] = binary[i];
 	}
 	// verify checksum
-	mask = 0xC;
-	checksum_calc = 0x0;
-	for(i=0; i < 36; i++) {
-		bit = mask & 0x1;
-		mask >>= 1;
-		if(bit == 0x1) {
-			mask ^= 0x9;
-		}
-		if(binary_cpy[i] == 1) {
-			checksum_calc ^= mask;
-		}
-	}
+	bits_to_bytes(binary_cpy, 0, 35, bytes);
+	checksum_calc = lfsr_digest4(&lfsr, bytes, 36, 0xC);
 	if(checksum != checksum_calc) {
 		logprintf(LOG_ERR, "fanju: parsecode - invalid checksum: %d calc: %d", checksum, checksum_calc);
 		return;
@@ -165,11 +158,11 @@ static void parseCode(void) {
 
 	if(channel != 4) {
 		fanju->message = json_mkobject();
-		json_append_member(fanju->message, "id", json_mknumber(id, 0));
-		json_append_member(fanju->message, "temperature", json_mknumber(temperature, 1));
-		json_append_member(fanju->message, "humidity", json_mknumber(humidity, 1));
-		json_append_member(fanju->message, "battery", json_mknumber(battery, 0));
-		json_append_member(fanju->message, "channel", json_mknumber(channel, 0));
+		json_append_member_static(fanju->message, "id", json_mknumber(id, 0));
+		json_append_member_static(fanju->message, "temperature", json_mknumber(temperature, 1));
+		json_append_member_static(fanju->message, "humidity", json_mknumber(humidity, 1));
+		json_append_member_static(fanju->message, "battery", json_mknumber(battery, 0));
+		json_append_member_static(fanju->message, "channel", json_mknumber(channel, 0));
 	}
 }
 
@@ -248,6 +241,7 @@ void fanjuInit(void) {
 	fanju->maxrawlen = RAW_LENGTH;
 	fanju->maxgaplen = MAX_PULSE_LENGTH*PULSE_DIV;
 	fanju->mingaplen = MIN_PULSE_LENGTH*PULSE_DIV;
+	fanju->checksum = 1;
 
 	options_add(&fanju->options, "i", "id", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "[0-9]");
 	options_add(&fanju->options, "c", "channel", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "[1-3]");
@@ -266,6 +260,8 @@ void fanjuInit(void) {
 	fanju->checkValues=&checkValues;
 	fanju->validate=&validate;
 	fanju->gc=&gc;
+
+	lfsr_digest4_init(&lfsr, 0x9);
 }
 
 #if defined(MODULE) && !defined(_WIN32)
@@ -9,6 +9,7 @@
 
 #include "../../core/log.h"
 #include "../../core/binary.h"
+#include "../../core/checksum.h"
 #include "../../core/gc.h"
 #include "../protocol.h"
 #include "funkbus.h"
@@ -37,26 +38,26 @@
 static void createMessageRemote(const funkbus_packet_t * packet, int raw[], size_t raw_len) {
     funkbus->message = json_mkobject();
 
-    json_append_member(funkbus->message, "type", json_mkstring("remote"));
-    json_append_member(funkbus->message, "id", json_mknumber(packet->sn, 0));
-    json_append_member(funkbus->message, "battery_ok", json_mkbool(packet->bat ? 0 : 1));
-    json_append_member(funkbus->message, "command", json_mknumber(packet->command, 0));
-    json_append_member(funkbus->message, "group", json_mknumber(packet->group, 0));
-    json_append_member(funkbus->message, "channel", json_mknumber(((packet->group << 3) + packet->command), 0));
-    json_append_member(funkbus->message, "action", json_mknumber(packet->action, 0));
-    json_append_member(funkbus->message, "repeat", json_mkbool(packet->repeat));
-    json_append_member(funkbus->message, "longpress", json_mkbool(packet->longpress));
+    json_append_member_static(funkbus->message, "type", json_mkstring("remote"));
+    json_append_member_static(funkbus->message, "id", json_mknumber(packet->sn, 0));
+    json_append_member_static(funkbus->message, "battery_ok", json_mkbool(packet->bat ? 0 : 1));
+    json_append_member_static(funkbus->message, "command", json_mknumber(packet->command, 0));
+    json_append_member_static(funkbus->message, "group", json_mknumber(packet->group, 0));
+    json_append_member_static(funkbus->message, "channel", json_mknumber(((packet->group << 3) + packet->command), 0));
+    json_append_member_static(funkbus->message, "action", json_mknumber(packet->action, 0));
+    json_append_member_static(funkbus->message, "repeat", json_mkbool(packet->repeat));
+    json_append_member_static(funkbus->message, "longpress", json_mkbool(packet->longpress));
 
 #ifdef FUNKBUS_RAW
     if(raw_len) {
-        json_append_member(funkbus->message, "parity", json_mkbool(packet->parity));
-        json_append_member(funkbus->message, "check", json_mknumber(packet->check, 0));
+        json_append_member_static(funkbus->message, "parity", json_mkbool(packet->parity));
+        json_append_member_static(funkbus->message, "check", json_mknumber(packet->check, 0));
 
         struct JsonNode * jraw = json_mkarray();
         for(uint8_t i = 0; i < raw_len; i++) {
             json_append_element(jraw, json_mknumber(raw[i], 0));
         }
-        json_append_member(funkbus->message, "raw", jraw);
+        json_append_member_static(funkbus->message, "raw", jraw);
     }
 #endif
 }
@@ -72,49 +73,20 @@ static int validate(void) {
     return -1;
 }
 
-static uint8_t parity8(uint8_t byte) {
-    byte ^= byte >> 4;
-    byte &= 0xf;
-    return (0x6996 >> byte) & 0x01;
-}
-
-static uint8_t xor_bytes(int raw[], size_t len) {
-    uint8_t result = 0;
-    for(uint8_t i = 0; i < len * 8; i += 8) {
-        result ^= binToDecRev(raw, i, i + 7);
-    }
-    return result;
-}
+// low nibble of 0x8C, 0x32, 0xC8 and 0x23 xored for each set bit (8, 4, 2, 1)
+static const uint8_t check_table[16] = {
+    0x0, 0x3, 0x8, 0xB, 0x2, 0x1, 0xA, 0x9,
+    0xC, 0xF, 0x4, 0x7, 0xE, 0xD, 0x6, 0x5
+};
 
 static uint8_t calc_checksum(int raw[], size_t len) {
-    const uint8_t full_bytes = len / 8;
-    const uint8_t bits_left  = len % 8;
-
-    uint8_t xor = xor_bytes(raw, full_bytes);
-    if(bits_left) {
-        xor ^= (binToDecRev(raw, full_bytes * 8, len - 1) << (8 - bits_left));
-    }
+    uint8_t bytes[RAW_LENGTH_MAX / 8 + 1];
+    const size_t bytes_len = bits_to_bytes(raw, 0, len - 1, bytes);
 
+    const uint8_t xor = xor_bytes(bytes, bytes_len);
     const uint8_t xor_nibble = ((xor&0xF0) >> 4) ^ (xor&0x0F);
 
-    uint8_t result = 0;
-    if(xor_nibble & 0x8) {
-        result ^= 0x8C;
-    }
-    if(xor_nibble & 0x4) {
-        result ^= 0x32;
-    }
-    if(xor_nibble & 0x2) {
-        result ^= 0xC8;
-    }
-    if(xor_nibble & 0x01) {
-        result ^= 0x23;
-    }
-
-    result = result & 0xF;
-    result |= (parity8(xor) << 4);
-
-    return result;
+    return check_table[xor_nibble] | (parity8(xor) << 4);
 }
 
 static void varToBin(uint32_t value, int binary[], uint8_t len) {
@@ -353,6 +325,7 @@ void funkbusInit(void) {
     funkbus->maxrawlen = RAW_LENGTH_MAX;
     funkbus->maxgaplen = FUNKBUS_LONG_MAX * PULSE_DIV;
     funkbus->mingaplen = FUNKBUS_SHORT_MIN * PULSE_DIV;
+    funkbus->checksum = 1;
 
     funkbus->parseCode  = &parseCode;
     funkbus->createCode = &createCode;
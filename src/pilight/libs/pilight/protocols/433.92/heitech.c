@@ -50,13 +50,13 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int unitcode, int state) {
 	heitech->message = json_mkobject();
-	json_append_member(heitech->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(heitech->message, "unitcode", json_mknumber(unitcode, 0));
+	json_append_member_static(heitech->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(heitech->message, "unitcode", json_mknumber(unitcode, 0));
 
 	if(state == 0) {
-		json_append_member(heitech->message, "state", json_mkstring("on"));
+		json_append_member_static(heitech->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(heitech->message, "state", json_mkstring("off"));
+		json_append_member_static(heitech->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int programcode, int state) {
 	impuls->message = json_mkobject();
-	json_append_member(impuls->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(impuls->message, "programcode", json_mknumber(programcode, 0));
+	json_append_member_static(impuls->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(impuls->message, "programcode", json_mknumber(programcode, 0));
 	if(state == 1) {
-		json_append_member(impuls->message, "state", json_mkstring("on"));
+		json_append_member_static(impuls->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(impuls->message, "state", json_mkstring("off"));
+		json_append_member_static(impuls->message, "state", json_mkstring("off"));
 	}
 }
 
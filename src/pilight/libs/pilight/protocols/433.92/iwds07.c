@@ -39,19 +39,19 @@ static int validate(void) {
 
 static void createMessage(int unit, int alert, int state, int fault) {
 	iwds07->message=json_mkobject();
-	json_append_member(iwds07->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(iwds07->message, "unit", json_mknumber(unit, 0));
 
     if(alert == 0) {
         if(fault == 1) {
-            json_append_member(iwds07->message, "state", json_mkstring("tamped"));
+            json_append_member_static(iwds07->message, "state", json_mkstring("tamped"));
         } else {
-            json_append_member(iwds07->message, "state", json_mkstring("low"));
+            json_append_member_static(iwds07->message, "state", json_mkstring("low"));
         }
     } else {
         if(state == 1) {
-            json_append_member(iwds07->message, "state", json_mkstring("closed"));
+            json_append_member_static(iwds07->message, "state", json_mkstring("closed"));
         } else {
-            json_append_member(iwds07->message, "state", json_mkstring("opened"));
+            json_append_member_static(iwds07->message, "state", json_mkstring("opened"));
         }
     }
 }
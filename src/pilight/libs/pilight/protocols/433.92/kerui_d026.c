@@ -39,21 +39,21 @@ static int validate(void) {
 
 static void createMessage(int unitcode, int state, int state2, int state3, int state4) {
 	kerui_D026->message = json_mkobject();
-	json_append_member(kerui_D026->message, "unitcode", json_mknumber(unitcode, 0));
+	json_append_member_static(kerui_D026->message, "unitcode", json_mknumber(unitcode, 0));
 	int battery = 1;
 
 	if(state4 == 0) {
-		json_append_member(kerui_D026->message, "state", json_mkstring("opened"));
+		json_append_member_static(kerui_D026->message, "state", json_mkstring("opened"));
 	} else if(state == 0) {
-		json_append_member(kerui_D026->message, "state", json_mkstring("closed"));
+		json_append_member_static(kerui_D026->message, "state", json_mkstring("closed"));
 	} else if(state2 == 0) {
-		json_append_member(kerui_D026->message, "state", json_mkstring("tamper"));
+		json_append_member_static(kerui_D026->message, "state", json_mkstring("tamper"));
 /*	} else if(state3 == 0) {
-		json_append_member(kerui_D026->message, "state", json_mkstring("not used"));
+		json_append_member_static(kerui_D026->message, "state", json_mkstring("not used"));
 */	} else {
 		battery = 0;
 	}
-	json_append_member(kerui_D026->message, "battery", json_mknumber(battery, 0));
+	json_append_member_static(kerui_D026->message, "battery", json_mknumber(battery, 0));
 }
 
 static void parseCode(void) {
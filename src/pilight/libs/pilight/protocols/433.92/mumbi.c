@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int unitcode, int state) {
 	mumbi->message = json_mkobject();
-	json_append_member(mumbi->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(mumbi->message, "unitcode", json_mknumber(unitcode, 0));
+	json_append_member_static(mumbi->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(mumbi->message, "unitcode", json_mknumber(unitcode, 0));
 	if(state == 1) {
-		json_append_member(mumbi->message, "state", json_mkstring("on"));
+		json_append_member_static(mumbi->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(mumbi->message, "state", json_mkstring("off"));
+		json_append_member_static(mumbi->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -123,9 +123,9 @@ static void parseCode(void) {
     while (tmp) {
         if (tmp->id == id) {
             // store or apply the settings
-            temperature += settings->temperature_offset;
-            humidity += settings->humidity_offset;
-            temperature_decimals = settings->temperature_decimals;
+            temperature += tmp->temperature_offset;
+            humidity += tmp->humidity_offset;
+            temperature_decimals = tmp->temperature_decimals;
             break;
         }
         tmp = tmp->next;
@@ -133,11 +133,11 @@ static void parseCode(void) {
 
     // build the JSON object
     nexus->message = json_mkobject();
-    json_append_member(nexus->message, "id", json_mknumber(id, 0));
-    json_append_member(nexus->message, "channel", json_mknumber(channel, 0));
-    json_append_member(nexus->message, "battery", json_mknumber(battery, 0));
-    json_append_member(nexus->message, "temperature", json_mknumber(temperature, temperature_decimals));
-    json_append_member(nexus->message, "humidity", json_mknumber(humidity, 0));
+    json_append_member_static(nexus->message, "id", json_mknumber(id, 0));
+    json_append_member_static(nexus->message, "channel", json_mknumber(channel, 0));
+    json_append_member_static(nexus->message, "battery", json_mknumber(battery, 0));
+    json_append_member_static(nexus->message, "temperature", json_mknumber(temperature, temperature_decimals));
+    json_append_member_static(nexus->message, "humidity", json_mknumber(humidity, 0));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
@@ -67,10 +67,10 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, double temperature, double humidity) {
 	ninjablocks_weather->message = json_mkobject();
-	json_append_member(ninjablocks_weather->message, "id", json_mknumber(id, 0));
-	json_append_member(ninjablocks_weather->message, "unit", json_mknumber(unit, 0));
-	json_append_member(ninjablocks_weather->message, "temperature", json_mknumber(temperature/100, 2));
-	json_append_member(ninjablocks_weather->message, "humidity", json_mknumber(humidity, 0));
+	json_append_member_static(ninjablocks_weather->message, "id", json_mknumber(id, 0));
+	json_append_member_static(ninjablocks_weather->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(ninjablocks_weather->message, "temperature", json_mknumber(temperature/100, 2));
+	json_append_member_static(ninjablocks_weather->message, "humidity", json_mknumber(humidity, 0));
 }
 
 static void parseCode(void) {
@@ -211,6 +211,7 @@ void ninjablocksWeatherInit(void) {
 	ninjablocks_weather->maxrawlen = MAX_RAW_LENGTH;
 	ninjablocks_weather->mingaplen = MIN_PULSE_LENGTH*PULSE_DIV;
 	ninjablocks_weather->maxgaplen = MAX_PULSE_LENGTH*PULSE_DIV;
+	ninjablocks_weather->checksum = 1;
 
 	// sync-id[4]; Homecode[4], Channel Code[2], Sync[3], Humidity[7], Temperature[15], Footer [1]
 	options_add(&ninjablocks_weather->options, "u", "unit", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "^([0-9]|1[0-5])$");
@@ -208,15 +208,15 @@ static void createMessage(int id, int unit, int state, int seq, int learn) {
 	bincode[BIN_LENGTH] = '\0'; /* end of string */
 
 	quigg_gt1000->message = json_mkobject();
-	json_append_member(quigg_gt1000->message, "id", json_mknumber(id, 0));
-	json_append_member(quigg_gt1000->message, "unit", json_mknumber(unit, 0));
-	json_append_member(quigg_gt1000->message, "seq", json_mknumber(seq, 0));
+	json_append_member_static(quigg_gt1000->message, "id", json_mknumber(id, 0));
+	json_append_member_static(quigg_gt1000->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(quigg_gt1000->message, "seq", json_mknumber(seq, 0));
 	if(state == 1) {
-		json_append_member(quigg_gt1000->message, "state", json_mkstring("on"));
+		json_append_member_static(quigg_gt1000->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(quigg_gt1000->message, "state", json_mkstring("off"));
+		json_append_member_static(quigg_gt1000->message, "state", json_mkstring("off"));
 	}
-	json_append_member(quigg_gt1000->message, "code", json_mkstring(bincode));
+	json_append_member_static(quigg_gt1000->message, "code", json_mkstring(bincode));
 }
 
 static int fillLow(int idx) {
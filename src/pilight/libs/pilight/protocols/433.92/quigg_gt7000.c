@@ -57,17 +57,17 @@ static int validate(void) {
 
 static void createMessage(int id, int state, int unit, int all, int learn) {
 	quigg_gt7000->message = json_mkobject();
-	json_append_member(quigg_gt7000->message, "id", json_mknumber(id, 0));
+	json_append_member_static(quigg_gt7000->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(quigg_gt7000->message, "all", json_mknumber(all, 0));
+		json_append_member_static(quigg_gt7000->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(quigg_gt7000->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(quigg_gt7000->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(quigg_gt7000->message, "state", json_mkstring("on"));
+		json_append_member_static(quigg_gt7000->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(quigg_gt7000->message, "state", json_mkstring("off"));
+		json_append_member_static(quigg_gt7000->message, "state", json_mkstring("off"));
 	}
 
 	if(learn == 1) {
@@ -269,6 +269,7 @@ void quiggGT7000Init(void) {
 	quigg_gt7000->maxrawlen = RAW_LENGTH;
 	quigg_gt7000->maxgaplen = (int)(PULSE_QUIGG_FOOTER*0.9);
 	quigg_gt7000->mingaplen = (int)(PULSE_QUIGG_FOOTER*1.1);
+	quigg_gt7000->checksum = 1;
 
 	options_add(&quigg_gt7000->options, "t", "on", OPTION_NO_VALUE, DEVICES_STATE, JSON_STRING, NULL, NULL);
 	options_add(&quigg_gt7000->options, "f", "off", OPTION_NO_VALUE, DEVICES_STATE, JSON_STRING, NULL, NULL);
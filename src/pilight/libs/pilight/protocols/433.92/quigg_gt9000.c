@@ -135,14 +135,14 @@ static void createMessage(int *binary, int systemcode, int state, int unit) {
                 	}
         	}
         	binaryCh[RAW_LENGTH/2-1] = '\0';
-        	json_append_member(quigg_gt9000->message, "binary", json_mkstring(binaryCh));
+        	json_append_member_static(quigg_gt9000->message, "binary", json_mkstring(binaryCh));
         }
-	json_append_member(quigg_gt9000->message, "id", json_mknumber(systemcode, 0));
-	json_append_member(quigg_gt9000->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(quigg_gt9000->message, "id", json_mknumber(systemcode, 0));
+	json_append_member_static(quigg_gt9000->message, "unit", json_mknumber(unit, 0));
 	if(state == 1) {
-		json_append_member(quigg_gt9000->message, "state", json_mkstring("on"));
+		json_append_member_static(quigg_gt9000->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(quigg_gt9000->message, "state", json_mkstring("off"));
+		json_append_member_static(quigg_gt9000->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -58,16 +58,16 @@ static int validate(void) {
 
 static void createMessage(int id, int state, int unit, int all, int learn) {
 	quigg_screen->message = json_mkobject();
-	json_append_member(quigg_screen->message, "id", json_mknumber(id, 0));
+	json_append_member_static(quigg_screen->message, "id", json_mknumber(id, 0));
 	if(all==1) {
-		json_append_member(quigg_screen->message, "all", json_mknumber(all, 0));
+		json_append_member_static(quigg_screen->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(quigg_screen->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(quigg_screen->message, "unit", json_mknumber(unit, 0));
 	}
 	if(state==0) {
-		json_append_member(quigg_screen->message, "state", json_mkstring("up"));
+		json_append_member_static(quigg_screen->message, "state", json_mkstring("up"));
 	} else {
-		json_append_member(quigg_screen->message, "state", json_mkstring("down"));
+		json_append_member_static(quigg_screen->message, "state", json_mkstring("down"));
 	}
 
 	if(learn == 1) {
@@ -286,6 +286,7 @@ void quiggScreenInit(void) {
 	quigg_screen->maxrawlen = RAW_LENGTH;
 	quigg_screen->maxgaplen = (int)(PULSE_QUIGG_SCREEN_FOOTER*0.9);
 	quigg_screen->mingaplen = (int)(PULSE_QUIGG_SCREEN_FOOTER*1.1);
+	quigg_screen->checksum = 1;
 
 	options_add(&quigg_screen->options, "t", "up", OPTION_NO_VALUE, DEVICES_STATE, JSON_STRING, NULL, NULL);
 	options_add(&quigg_screen->options, "f", "down", OPTION_NO_VALUE, DEVICES_STATE, JSON_STRING, NULL, NULL);
@@ -49,16 +49,16 @@ static int validate(void) {
 
 static void createMessage(int id, int state, int unit, int all) {
 	rc101->message = json_mkobject();
-	json_append_member(rc101->message, "id", json_mknumber(id, 0));
+	json_append_member_static(rc101->message, "id", json_mknumber(id, 0));
 	if(all == 1) {
-		json_append_member(rc101->message, "all", json_mknumber(1, 0));
+		json_append_member_static(rc101->message, "all", json_mknumber(1, 0));
 	} else {
-		json_append_member(rc101->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(rc101->message, "unit", json_mknumber(unit, 0));
 	}
 	if(state == 1) {
-		json_append_member(rc101->message, "state", json_mkstring("on"));
+		json_append_member_static(rc101->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(rc101->message, "state", json_mkstring("off"));
+		json_append_member_static(rc101->message, "state", json_mkstring("off"));
 	}
 }
 
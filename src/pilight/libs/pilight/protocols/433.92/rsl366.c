@@ -52,12 +52,12 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int programcode, int state) {
 	rsl366->message = json_mkobject();
-	json_append_member(rsl366->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(rsl366->message, "programcode", json_mknumber(programcode, 0));
+	json_append_member_static(rsl366->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(rsl366->message, "programcode", json_mknumber(programcode, 0));
 	if(state == 1) {
-		json_append_member(rsl366->message, "state", json_mkstring("on"));
+		json_append_member_static(rsl366->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(rsl366->message, "state", json_mkstring("off"));
+		json_append_member_static(rsl366->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -49,12 +49,12 @@ static int validate(void) {
 
 static void createMessage(int systemcode, int unitcode, int state) {
 	sc2262->message = json_mkobject();
-	json_append_member(sc2262->message, "systemcode", json_mknumber(systemcode, 0));
-	json_append_member(sc2262->message, "unitcode", json_mknumber(unitcode, 0));
+	json_append_member_static(sc2262->message, "systemcode", json_mknumber(systemcode, 0));
+	json_append_member_static(sc2262->message, "unitcode", json_mknumber(unitcode, 0));
 	if(state == 0) {
-		json_append_member(sc2262->message, "state", json_mkstring("opened"));
+		json_append_member_static(sc2262->message, "state", json_mkstring("opened"));
 	} else {
-		json_append_member(sc2262->message, "state", json_mkstring("closed"));
+		json_append_member_static(sc2262->message, "state", json_mkstring("closed"));
 	}
 }
 
@@ -71,8 +71,8 @@ static void parseCode(void) {
 	id = (~id) & 1023;
 
 	secudo_smoke->message = json_mkobject();
-	json_append_member(secudo_smoke->message, "id", json_mknumber(id, 0));
-	json_append_member(secudo_smoke->message, "state", json_mkstring("alarm"));
+	json_append_member_static(secudo_smoke->message, "id", json_mknumber(id, 0));
+	json_append_member_static(secudo_smoke->message, "state", json_mkstring("alarm"));
 }
 
 #if !defined(MODULE) && !defined(_WIN32)
@@ -49,11 +49,11 @@ static int validate(void) {
 
 static void createMessage(int id, int state) {
 	selectremote->message = json_mkobject();
-	json_append_member(selectremote->message, "id", json_mknumber(id, 0));
+	json_append_member_static(selectremote->message, "id", json_mknumber(id, 0));
 	if(state == 1) {
-		json_append_member(selectremote->message, "state", json_mkstring("on"));
+		json_append_member_static(selectremote->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(selectremote->message, "state", json_mkstring("off"));
+		json_append_member_static(selectremote->message, "state", json_mkstring("off"));
 	}
 }
 
@@ -43,18 +43,18 @@ static int validate(void) {
 static void createMessage(int id, int unit, int state, int all, int learn) {
 	smartwares_switch->message = json_mkobject();
 
-	json_append_member(smartwares_switch->message, "id", json_mknumber(id, 0));
+	json_append_member_static(smartwares_switch->message, "id", json_mknumber(id, 0));
 
 	if(all == 1) {
-		json_append_member(smartwares_switch->message, "all", json_mknumber(all, 0));
+		json_append_member_static(smartwares_switch->message, "all", json_mknumber(all, 0));
 	} else {
-		json_append_member(smartwares_switch->message, "unit", json_mknumber(unit, 0));
+		json_append_member_static(smartwares_switch->message, "unit", json_mknumber(unit, 0));
 	}
 
 	if(state == 1) {
-		json_append_member(smartwares_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(smartwares_switch->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(smartwares_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(smartwares_switch->message, "state", json_mkstring("off"));
 	}
 
 	if(learn == 1) {
@@ -108,11 +108,11 @@ static void parseCode(void) {
 	humidity += humi_offset;
 
 	tcm->message = json_mkobject();
-	json_append_member(tcm->message, "id", json_mknumber(id, 0));
-	json_append_member(tcm->message, "temperature", json_mknumber(temperature/10, 1));
-	json_append_member(tcm->message, "humidity", json_mknumber(humidity, 0));
-	json_append_member(tcm->message, "battery", json_mknumber(battery, 0));
-	json_append_member(tcm->message, "button", json_mknumber(button, 0));
+	json_append_member_static(tcm->message, "id", json_mknumber(id, 0));
+	json_append_member_static(tcm->message, "temperature", json_mknumber(temperature/10, 1));
+	json_append_member_static(tcm->message, "humidity", json_mknumber(humidity, 0));
+	json_append_member_static(tcm->message, "battery", json_mknumber(battery, 0));
+	json_append_member_static(tcm->message, "button", json_mknumber(button, 0));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
@@ -52,13 +52,13 @@ static int validate(void) {
 
 static void createMessage(int id, int unit, int state) {
 	techlico_switch->message = json_mkobject();
-	json_append_member(techlico_switch->message, "id", json_mknumber(id, 0));
-	json_append_member(techlico_switch->message, "unit", json_mknumber(unit, 0));
+	json_append_member_static(techlico_switch->message, "id", json_mknumber(id, 0));
+	json_append_member_static(techlico_switch->message, "unit", json_mknumber(unit, 0));
 	if(state == 0) {
-		json_append_member(techlico_switch->message, "state", json_mkstring("off"));
+		json_append_member_static(techlico_switch->message, "state", json_mkstring("off"));
 	}
 	if(state == 1) {
-		json_append_member(techlico_switch->message, "state", json_mkstring("on"));
+		json_append_member_static(techlico_switch->message, "state", json_mkstring("on"));
 	}
 }
 
@@ -94,10 +94,10 @@ static void parseCode(void) {
 	humidity += humi_offset;
 
 	teknihall->message = json_mkobject();
-	json_append_member(teknihall->message, "id", json_mknumber(id, 1));
-	json_append_member(teknihall->message, "temperature", json_mknumber(temperature/10, 1));
-	json_append_member(teknihall->message, "humidity", json_mknumber(humidity, 1));
-	json_append_member(teknihall->message, "battery", json_mknumber(battery, 1));
+	json_append_member_static(teknihall->message, "id", json_mknumber(id, 1));
+	json_append_member_static(teknihall->message, "temperature", json_mknumber(temperature/10, 1));
+	json_append_member_static(teknihall->message, "humidity", json_mknumber(humidity, 1));
+	json_append_member_static(teknihall->message, "battery", json_mknumber(battery, 1));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
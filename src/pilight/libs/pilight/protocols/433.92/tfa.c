@@ -27,6 +27,7 @@
 #include "../../core/log.h"
 #include "../protocol.h"
 #include "../../core/binary.h"
+#include "../../core/checksum.h"
 #include "../../core/gc.h"
 #include "tfa.h"
 
@@ -48,6 +49,7 @@ typedef struct settings_t {
 } settings_t;
 
 static struct settings_t *settings = NULL;
+static crc4_t crc4;
 
 static int validate(void) {
 	if(tfa->rawlen == MIN_RAW_LENGTH || tfa->rawlen == MED_RAW_LENGTH || tfa->rawlen == MAX_RAW_LENGTH) {
@@ -61,6 +63,7 @@ static int validate(void) {
 
 static void parseCode(void) {
 	int binary[RAW_LENGTH/2];
+	uint8_t bytes[RAW_LENGTH/16+1];
 	int temp1 = 0, temp2 = 0, temp3 = 0;
 	int humi1 = 0, humi2 = 0;
 	int id = 0, battery = 0, crc = 0;
@@ -91,13 +94,8 @@ static void parseCode(void) {
 	}
 
 	if(tfa->rawlen == MED_RAW_LENGTH || tfa->rawlen == MAX_RAW_LENGTH) {
-		for(i=0;i<34;i++) {
-			if(binary[i] != (crc&1)) {
-				crc = (crc>>1) ^ 12;
-			} else {
-				crc = (crc>>1);
-			}
-		}
+		bits_to_bytes_rev(binary, 0, 33, bytes);
+		crc = crc4_rev(&crc4, bytes, 34, 0);
 		crc ^= binToDec(binary, 34, 37);
 		if (crc != binToDec(binary, 38, 41)) {
 			return; // incorrect checksum
@@ -163,11 +161,11 @@ static void parseCode(void) {
 	humidity += humi_offset;
 
 	tfa->message = json_mkobject();
-	json_append_member(tfa->message, "id", json_mknumber(id, 0));
-	json_append_member(tfa->message, "temperature", json_mknumber(temperature/100, 2));
-	json_append_member(tfa->message, "humidity", json_mknumber(humidity, 2));
-	json_append_member(tfa->message, "battery", json_mknumber(battery, 0));
-	json_append_member(tfa->message, "channel", json_mknumber(channel, 0));
+	json_append_member_static(tfa->message, "id", json_mknumber(id, 0));
+	json_append_member_static(tfa->message, "temperature", json_mknumber(temperature/100, 2));
+	json_append_member_static(tfa->message, "humidity", json_mknumber(humidity, 2));
+	json_append_member_static(tfa->message, "battery", json_mknumber(battery, 0));
+	json_append_member_static(tfa->message, "channel", json_mknumber(channel, 0));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
@@ -253,6 +251,7 @@ void tfaInit(void) {
 	tfa->mingaplen = MIN_PULSE_LENGTH*PULSE_DIV;
 	tfa->minrawlen = MIN_RAW_LENGTH;
 	tfa->maxrawlen = MAX_RAW_LENGTH;
+	tfa->checksum = 1;
 
 	options_add(&tfa->options, "t", "temperature", OPTION_HAS_VALUE, DEVICES_VALUE, JSON_NUMBER, NULL, "^[0-9]{1,3}$");
 	options_add(&tfa->options, "i", "id", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "[0-9]");
@@ -273,6 +272,8 @@ void tfaInit(void) {
 	tfa->checkValues=&checkValues;
 	tfa->validate=&validate;
 	tfa->gc=&gc;
+
+	crc4_rev_init(&crc4, 12);
 }
 
 #if defined(MODULE) && !defined(_WIN32)
@@ -137,9 +137,9 @@ static void parseCode(void) {
 	}
 
 	tfa2017->message = json_mkobject();
-	json_append_member(tfa2017->message, "id", json_mknumber(channel, 0));
-	json_append_member(tfa2017->message, "temperature", json_mknumber(temperature, 2));
-	json_append_member(tfa2017->message, "humidity", json_mknumber(humidity, 2));
+	json_append_member_static(tfa2017->message, "id", json_mknumber(channel, 0));
+	json_append_member_static(tfa2017->message, "temperature", json_mknumber(temperature, 2));
+	json_append_member_static(tfa2017->message, "humidity", json_mknumber(humidity, 2));
 }
 
 static int checkValues(struct JsonNode *jvalues) {
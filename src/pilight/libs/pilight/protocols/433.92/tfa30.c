@@ -29,6 +29,7 @@
 #include "../../core/log.h"
 #include "../protocol.h"
 #include "../../core/binary.h"
+#include "../../core/checksum.h"
 #include "../../core/gc.h"
 #include "tfa30.h"
 //
@@ -67,11 +68,12 @@ static void parseCode(void) {
 	int i = 0, x = 0, type = 0, id = 0, binary[MAX_RAW_LENGTH/2];
 	double temp_offset = 0.0, humi_offset = 0.0;
 	double humidity = 0.0, temperature = 0.0;
-	int n0 = 0, n1 = 0, n2 = 0, n3 = 0, n3b = 0;
-	int n4 = 0, n5 = 0, n6 = 0, n7 = 0, n8 = 0;
-	int n9 = 0, n10 = 0;
+	int n1 = 0, n2 = 0, n3b = 0;
+	int n5 = 0, n6 = 0, n7 = 0;
+	int n10 = 0;
 	int y = 0;
-	int checksum = 1;
+	int checksum = 1, sum = 0;
+	uint8_t bytes[MAX_RAW_LENGTH/16+1];
 
 	if(tfa30->rawlen>MAX_RAW_LENGTH) {
 		logprintf(LOG_ERR, "tfa30: parsecode - invalid parameter passed %d", tfa30->rawlen);
@@ -93,17 +95,15 @@ static void parseCode(void) {
 	}
 
  	n10=binToDecRev(binary, 40, 43);
- 	n9=binToDecRev(binary, 36, 39);
-	n8=binToDecRev(binary, 32, 35);
 	n7=binToDecRev(binary, 28, 31);
 	n6=binToDecRev(binary, 24, 27);
 	n5=binToDecRev(binary, 20, 23);
-	n4=binToDecRev(binary, 16, 19);
 	n3b=binToDecRev(binary, 12, 18);
-	n3=binToDecRev(binary, 12, 15);
 	n2=binToDecRev(binary, 8, 11);
 	n1=binToDecRev(binary, 4, 7);
-	n0=binToDecRev(binary, 0, 3);
+
+	bits_to_bytes(binary, 0, 39, bytes);
+	sum = add_nibbles(bytes, 10);
 
 	id = n3b;
 
@@ -120,7 +120,7 @@ static void parseCode(void) {
 	// Temp
 	if((n1 == 0xa) & (n2 == 0x0)) {
 		type = 0x1;
-		checksum = (n0+n1+n2+n3+n4+n5+n6+n7+n8+n9) & 0xf;
+		checksum = sum & 0xf;
 		if(n10 != checksum) {
 			type=0x5;
 			return;
@@ -128,7 +128,7 @@ static void parseCode(void) {
 	// Hum
 	} else if((n1 == 0xa) & (n2 == 0xe)) {
 		type = 0x2;
-		checksum = (n0+n1+n2+n3+n4+n5+n6+n7+n8+n9) & 0xf;
+		checksum = sum & 0xf;
 		if(n10 != checksum){
 			type=0x5;
 			return;
@@ -145,15 +145,15 @@ static void parseCode(void) {
 			temperature = (double)(n5-5)*10 + n6 + n7/10.0;
 			temperature += temp_offset;
 
-			json_append_member(tfa30->message, "id", json_mknumber(id, 0));
-			json_append_member(tfa30->message, "temperature", json_mknumber(temperature, 1));
+			json_append_member_static(tfa30->message, "id", json_mknumber(id, 0));
+			json_append_member_static(tfa30->message, "temperature", json_mknumber(temperature, 1));
 		break;
 		case 2:
 			humidity = (double)(n5)*10 + n6;
 			humidity += humi_offset;
 
-			json_append_member(tfa30->message, "id", json_mknumber(id, 0));
-			json_append_member(tfa30->message, "humidity", json_mknumber(humidity, 1));
+			json_append_member_static(tfa30->message, "id", json_mknumber(id, 0));
+			json_append_member_static(tfa30->message, "humidity", json_mknumber(humidity, 1));
 		break;
 		default:
 			json_delete(tfa30->message);
@@ -239,6 +239,7 @@ void tfa30Init(void) {
 	tfa30->maxrawlen = MAX_RAW_LENGTH;
 	tfa30->maxgaplen = MAX_PULSE_LENGTH*PULSE_DIV;
 	tfa30->mingaplen = MIN_PULSE_LENGTH*PULSE_DIV;
+	tfa30->checksum = 1;
 
 	options_add(&tfa30->options, "t", "temperature", OPTION_HAS_VALUE, DEVICES_VALUE, JSON_NUMBER, NULL, "^[0-9]{1,3}$");
 	options_add(&tfa30->options, "i", "id", OPTION_HAS_VALUE, DEVICES_ID, JSON_NUMBER, NULL, "[0-9]");
@@ -51,11 +51,11 @@ static int validate(void) {
 
 static void createMessage(char *id, int state) {
 	x10->message = json_mkobject();
-	json_append_member(x10->message, "id", json_mkstring(id));
+	json_append_member_static(x10->message, "id", json_mkstring(id));
 	if(state == 0) {
-		json_append_member(x10->message, "state", json_mkstring("on"));
+		json_append_member_static(x10->message, "state", json_mkstring("on"));
 	} else {
-		json_append_member(x10->message, "state", json_mkstring("off"));
+		json_append_member_static(x10->message, "state", json_mkstring("off"));
 	}
 }
 
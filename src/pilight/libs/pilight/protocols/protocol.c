@@ -28,6 +28,24 @@
 
 struct protocols_t *pilight_protocols = NULL;
 
+int log_mute = 0;
+
+#define DEVICES_ID 0
+#define DEVICES_STATE 1
+#define DEVICES_VALUE 2
+
+typedef struct protocol_arg_t {
+  protocol_t **protocol;
+  const char *name;
+  int type;
+} protocol_arg_t;
+
+static const protocol_arg_t protocol_args[] PROGMEM = {
+#define PROTOCOL_ARG(proto, name, type) {&proto, name, type},
+#include "protocol_args.h"
+#undef PROTOCOL_ARG
+};
+
 void protocol_init(void) {
   #include "protocol_init.h"
 }
@@ -69,6 +87,7 @@ void protocol_register(protocol_t **proto) {
 
   /* Arduino special, compare repeated messages*/
   (*proto)->old_content = NULL;
+  (*proto)->checksum = 0;
 
   struct protocols_t *pnode = MALLOC(sizeof(struct protocols_t));
   if(pnode == NULL) {
@@ -83,3 +102,34 @@ void protocol_register(protocol_t **proto) {
 void protocol_set_id(protocol_t *proto, char *id) {
   proto->id = id;
 }
+
+int protocol_missing_args(protocol_t *proto,
+                          int (*has)(const char *name, void *arg), void *arg,
+                          const char **missing, int max) {
+  const char *states[8];
+  int nrstates = 0, state = 0, nrmissing = 0;
+  size_t i = 0;
+
+  for(i=0;i<sizeof(protocol_args)/sizeof(protocol_args[0]);i++) {
+    protocol_t **p = (protocol_t **)pgm_read_ptr(&protocol_args[i].protocol);
+    const char *name = (const char *)pgm_read_ptr(&protocol_args[i].name);
+    if(*p != proto) {
+      continue;
+    }
+    if(pgm_read_byte(&protocol_args[i].type) == DEVICES_ID) {
+      if(has(name, arg) == 0 && nrmissing < max) {
+        missing[nrmissing++] = name;
+      }
+    } else if(has(name, arg) != 0) {
+      state = 1;
+    } else if(nrstates < (int)(sizeof(states)/sizeof(states[0]))) {
+      states[nrstates++] = name;
+    }
+  }
+  if(state == 0) {
+    for(i=0;i<(size_t)nrstates && nrmissing<max;i++) {
+      missing[nrmissing++] = states[i];
+    }
+  }
+  return nrmissing;
+}
@@ -100,6 +100,8 @@ typedef struct protocol_t {
 
   /* ESPiLight special, used to compare repeated messages*/
   char *old_content;
+  /* ESPiLight special, parseCode() only accepts frames with valid checksum */
+  int checksum;
 } protocol_t;
 
 typedef struct protocols_t {
@@ -113,6 +115,16 @@ extern struct protocols_t *pilight_protocols;
 void protocol_init(void);
 void protocol_set_id(protocol_t *proto, char *id);
 void protocol_register(protocol_t **proto);
+
+/*
+ * Collect the createCode() arguments of proto, that are missing according
+ * to has(): every id argument and, if no state or value argument is given,
+ * all state and value arguments. Returns the number of names stored to
+ * missing.
+ */
+int protocol_missing_args(protocol_t *proto,
+                          int (*has)(const char *name, void *arg), void *arg,
+                          const char **missing, int max);
 #define protocol_device_add(proto, id, desc)
 
 #ifndef PROTOCOL_STRUCT_EXTERN
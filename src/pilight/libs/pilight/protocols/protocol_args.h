@@ -0,0 +1,213 @@
+/* createCode() arguments from options_add(), generated by make */
+PROTOCOL_ARG(alecto_ws1700, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_ws1700, "id", DEVICES_ID)
+PROTOCOL_ARG(alecto_ws1700, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_ws1700, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wsd17, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wsd17, "id", DEVICES_ID)
+PROTOCOL_ARG(alecto_wx500, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "id", DEVICES_ID)
+PROTOCOL_ARG(alecto_wx500, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "windavg", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "winddir", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "windgust", DEVICES_VALUE)
+PROTOCOL_ARG(alecto_wx500, "rain", DEVICES_VALUE)
+PROTOCOL_ARG(arctech_contact, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_contact, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_contact, "opened", DEVICES_STATE)
+PROTOCOL_ARG(arctech_contact, "closed", DEVICES_STATE)
+PROTOCOL_ARG(arctech_dimmer, "dimlevel", DEVICES_VALUE)
+PROTOCOL_ARG(arctech_dimmer, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_dimmer, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_dimmer, "on", DEVICES_STATE)
+PROTOCOL_ARG(arctech_dimmer, "off", DEVICES_STATE)
+PROTOCOL_ARG(arctech_dusk, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_dusk, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_dusk, "dusk", DEVICES_STATE)
+PROTOCOL_ARG(arctech_dusk, "dawn", DEVICES_STATE)
+PROTOCOL_ARG(arctech_motion, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_motion, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_motion, "on", DEVICES_STATE)
+PROTOCOL_ARG(arctech_motion, "off", DEVICES_STATE)
+PROTOCOL_ARG(arctech_screen, "up", DEVICES_STATE)
+PROTOCOL_ARG(arctech_screen, "down", DEVICES_STATE)
+PROTOCOL_ARG(arctech_screen, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_screen, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_screen_old, "up", DEVICES_STATE)
+PROTOCOL_ARG(arctech_screen_old, "down", DEVICES_STATE)
+PROTOCOL_ARG(arctech_screen_old, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_screen_old, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(arctech_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(arctech_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(arctech_switch_old, "on", DEVICES_STATE)
+PROTOCOL_ARG(arctech_switch_old, "off", DEVICES_STATE)
+PROTOCOL_ARG(arctech_switch_old, "unit", DEVICES_ID)
+PROTOCOL_ARG(arctech_switch_old, "id", DEVICES_ID)
+PROTOCOL_ARG(auriol, "id", DEVICES_ID)
+PROTOCOL_ARG(auriol, "channel", DEVICES_ID)
+PROTOCOL_ARG(auriol, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(auriol, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(beamish_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(beamish_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(beamish_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(beamish_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(clarus_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(clarus_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(clarus_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(clarus_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(cleverwatts, "on", DEVICES_STATE)
+PROTOCOL_ARG(cleverwatts, "off", DEVICES_STATE)
+PROTOCOL_ARG(cleverwatts, "unit", DEVICES_ID)
+PROTOCOL_ARG(cleverwatts, "id", DEVICES_ID)
+PROTOCOL_ARG(conrad_rsl_contact, "id", DEVICES_ID)
+PROTOCOL_ARG(conrad_rsl_contact, "opened", DEVICES_STATE)
+PROTOCOL_ARG(conrad_rsl_contact, "closed", DEVICES_STATE)
+PROTOCOL_ARG(conrad_rsl_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(conrad_rsl_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(conrad_rsl_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(conrad_rsl_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(daycom, "on", DEVICES_STATE)
+PROTOCOL_ARG(daycom, "off", DEVICES_STATE)
+PROTOCOL_ARG(daycom, "unit", DEVICES_ID)
+PROTOCOL_ARG(daycom, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(daycom, "id", DEVICES_ID)
+PROTOCOL_ARG(ehome, "id", DEVICES_ID)
+PROTOCOL_ARG(ehome, "on", DEVICES_STATE)
+PROTOCOL_ARG(ehome, "off", DEVICES_STATE)
+PROTOCOL_ARG(elro_300_switch, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(elro_300_switch, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(elro_300_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(elro_300_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(elro_400_switch, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(elro_400_switch, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(elro_400_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(elro_400_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(elro_800_contact, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(elro_800_contact, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(elro_800_contact, "opened", DEVICES_STATE)
+PROTOCOL_ARG(elro_800_contact, "closed", DEVICES_STATE)
+PROTOCOL_ARG(elro_800_switch, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(elro_800_switch, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(elro_800_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(elro_800_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(eurodomest_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(eurodomest_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(eurodomest_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(eurodomest_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(ev1527, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(ev1527, "opened", DEVICES_STATE)
+PROTOCOL_ARG(ev1527, "closed", DEVICES_STATE)
+PROTOCOL_ARG(fanju, "id", DEVICES_ID)
+PROTOCOL_ARG(fanju, "channel", DEVICES_ID)
+PROTOCOL_ARG(fanju, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(fanju, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(fanju, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(heitech, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(heitech, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(heitech, "on", DEVICES_STATE)
+PROTOCOL_ARG(heitech, "off", DEVICES_STATE)
+PROTOCOL_ARG(impuls, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(impuls, "programcode", DEVICES_ID)
+PROTOCOL_ARG(impuls, "on", DEVICES_STATE)
+PROTOCOL_ARG(impuls, "off", DEVICES_STATE)
+PROTOCOL_ARG(iwds07, "unit", DEVICES_ID)
+PROTOCOL_ARG(iwds07, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(iwds07, "opened", DEVICES_STATE)
+PROTOCOL_ARG(iwds07, "closed", DEVICES_STATE)
+PROTOCOL_ARG(iwds07, "tamper", DEVICES_STATE)
+PROTOCOL_ARG(kerui_D026, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(kerui_D026, "opened", DEVICES_STATE)
+PROTOCOL_ARG(kerui_D026, "closed", DEVICES_STATE)
+PROTOCOL_ARG(kerui_D026, "tamper", DEVICES_STATE)
+PROTOCOL_ARG(kerui_D026, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(logilink_switch, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(logilink_switch, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(logilink_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(logilink_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(mumbi, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(mumbi, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(mumbi, "on", DEVICES_STATE)
+PROTOCOL_ARG(mumbi, "off", DEVICES_STATE)
+PROTOCOL_ARG(nexus, "id", DEVICES_ID)
+PROTOCOL_ARG(nexus, "channel", DEVICES_ID)
+PROTOCOL_ARG(nexus, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(nexus, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(nexus, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(ninjablocks_weather, "unit", DEVICES_ID)
+PROTOCOL_ARG(ninjablocks_weather, "id", DEVICES_ID)
+PROTOCOL_ARG(ninjablocks_weather, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(ninjablocks_weather, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(pollin, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(pollin, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(pollin, "on", DEVICES_STATE)
+PROTOCOL_ARG(pollin, "off", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt1000, "on", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt1000, "off", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt1000, "unit", DEVICES_ID)
+PROTOCOL_ARG(quigg_gt1000, "id", DEVICES_ID)
+PROTOCOL_ARG(quigg_gt7000, "on", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt7000, "off", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt7000, "unit", DEVICES_ID)
+PROTOCOL_ARG(quigg_gt7000, "id", DEVICES_ID)
+PROTOCOL_ARG(quigg_gt9000, "on", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt9000, "off", DEVICES_STATE)
+PROTOCOL_ARG(quigg_gt9000, "unit", DEVICES_ID)
+PROTOCOL_ARG(quigg_gt9000, "id", DEVICES_ID)
+PROTOCOL_ARG(quigg_screen, "up", DEVICES_STATE)
+PROTOCOL_ARG(quigg_screen, "down", DEVICES_STATE)
+PROTOCOL_ARG(quigg_screen, "unit", DEVICES_ID)
+PROTOCOL_ARG(quigg_screen, "id", DEVICES_ID)
+PROTOCOL_ARG(rc101, "id", DEVICES_ID)
+PROTOCOL_ARG(rc101, "unit", DEVICES_ID)
+PROTOCOL_ARG(rc101, "on", DEVICES_STATE)
+PROTOCOL_ARG(rc101, "off", DEVICES_STATE)
+PROTOCOL_ARG(rsl366, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(rsl366, "programcode", DEVICES_ID)
+PROTOCOL_ARG(rsl366, "on", DEVICES_STATE)
+PROTOCOL_ARG(rsl366, "off", DEVICES_STATE)
+PROTOCOL_ARG(sc2262, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(sc2262, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(sc2262, "opened", DEVICES_STATE)
+PROTOCOL_ARG(sc2262, "closed", DEVICES_STATE)
+PROTOCOL_ARG(secudo_smoke, "id", DEVICES_ID)
+PROTOCOL_ARG(secudo_smoke, "alarm", DEVICES_STATE)
+PROTOCOL_ARG(selectremote, "id", DEVICES_ID)
+PROTOCOL_ARG(selectremote, "on", DEVICES_STATE)
+PROTOCOL_ARG(selectremote, "off", DEVICES_STATE)
+PROTOCOL_ARG(silvercrest, "systemcode", DEVICES_ID)
+PROTOCOL_ARG(silvercrest, "unitcode", DEVICES_ID)
+PROTOCOL_ARG(silvercrest, "on", DEVICES_STATE)
+PROTOCOL_ARG(silvercrest, "off", DEVICES_STATE)
+PROTOCOL_ARG(smartwares_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(smartwares_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(smartwares_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(smartwares_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(tcm, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(tcm, "id", DEVICES_ID)
+PROTOCOL_ARG(tcm, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(tcm, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(techlico_switch, "on", DEVICES_STATE)
+PROTOCOL_ARG(techlico_switch, "off", DEVICES_STATE)
+PROTOCOL_ARG(techlico_switch, "unit", DEVICES_ID)
+PROTOCOL_ARG(techlico_switch, "id", DEVICES_ID)
+PROTOCOL_ARG(teknihall, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(teknihall, "id", DEVICES_ID)
+PROTOCOL_ARG(teknihall, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(teknihall, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(tfa, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(tfa, "id", DEVICES_ID)
+PROTOCOL_ARG(tfa, "channel", DEVICES_ID)
+PROTOCOL_ARG(tfa, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(tfa, "battery", DEVICES_VALUE)
+PROTOCOL_ARG(tfa2017, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(tfa2017, "id", DEVICES_ID)
+PROTOCOL_ARG(tfa2017, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(tfa30, "temperature", DEVICES_VALUE)
+PROTOCOL_ARG(tfa30, "id", DEVICES_ID)
+PROTOCOL_ARG(tfa30, "humidity", DEVICES_VALUE)
+PROTOCOL_ARG(x10, "on", DEVICES_STATE)
+PROTOCOL_ARG(x10, "off", DEVICES_STATE)
+PROTOCOL_ARG(x10, "id", DEVICES_ID)
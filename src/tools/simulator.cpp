@@ -0,0 +1,69 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#include "simulator.h"
+#include "transmitter.h"
+
+static sim_edge_t *sim_edges = nullptr;
+static size_t sim_size = 0;
+static size_t sim_count = 0;
+static Print *sim_output = nullptr;
+static SimulatorEdgeCallBack sim_callback = nullptr;
+static uint32_t sim_clock = 0;
+
+static unsigned long sim_now() { return sim_clock; }
+
+static void sim_wait(uint16_t duration) { sim_clock += duration; }
+
+static void sim_write(uint8_t pin, uint8_t level) {
+  const sim_edge_t edge = {sim_clock, pin, level};
+
+  if (sim_count < sim_size) {
+    sim_edges[sim_count] = edge;
+  }
+  sim_count++;
+  if (sim_output != nullptr) {
+    sim_output->print(edge.time);
+    sim_output->print(' ');
+    sim_output->print(edge.pin);
+    sim_output->print(' ');
+    sim_output->println(edge.level);
+  }
+  if (sim_callback != nullptr) {
+    sim_callback(&edge);
+  }
+}
+
+static const tx_backend_t sim_backend = {sim_now, sim_wait, sim_write};
+
+void sim_begin(sim_edge_t *edges, size_t size, Print *output,
+               SimulatorEdgeCallBack callback) {
+  sim_edges = edges;
+  sim_size = (edges != nullptr) ? size : 0;
+  sim_count = 0;
+  sim_output = output;
+  sim_callback = callback;
+  sim_clock = 0;
+  tx_set_backend(&sim_backend);
+}
+
+void sim_end() { tx_set_backend(nullptr); }
+
+size_t sim_recorded() { return sim_count; }
+
+uint32_t sim_time() { return sim_clock; }
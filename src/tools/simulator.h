@@ -0,0 +1,61 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _SIMULATOR_H_
+#define _SIMULATOR_H_
+
+#include <Arduino.h>
+
+/**
+ * Simulated transmitter: frames are sent immediately on a virtual clock and
+ * every output write is recorded. The end of a frame is a write of LOW
+ * after its (low) footer pulse.
+ */
+typedef struct sim_edge_t {
+  uint32_t time;  // virtual microseconds since sim_begin()
+  uint8_t pin;
+  uint8_t level;
+} sim_edge_t;
+
+typedef void (*SimulatorEdgeCallBack)(const sim_edge_t *edge);
+
+/**
+ * Start the simulation and reset the virtual clock. Edges are stored to
+ * edges (up to size, may be nullptr), printed to output as
+ * "time pin level" lines (may be nullptr) and passed to callback (may be
+ * nullptr).
+ */
+void sim_begin(sim_edge_t *edges, size_t size, Print *output,
+               SimulatorEdgeCallBack callback);
+
+/**
+ * Restore the hardware transmitter.
+ */
+void sim_end();
+
+/**
+ * Number of recorded edges, including those which did not fit into edges.
+ */
+size_t sim_recorded();
+
+/**
+ * Virtual time in microseconds.
+ */
+uint32_t sim_time();
+
+#endif  //_SIMULATOR_H_
@@ -0,0 +1,731 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#include "transmitter.h"
+#include <stddef.h>
+#include <algorithm>
+#include <limits>
+#ifdef ESP32
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+#endif
+
+// ESP32 doesn't define ICACHE_RAM_ATTR
+#ifndef ICACHE_RAM_ATTR
+#define ICACHE_RAM_ATTR IRAM_ATTR
+#endif
+
+#define TX_COMPLETED_SIZE (2 * TX_QUEUE_SIZE)
+
+// Shortest time the timer is armed with, if an edge is already late
+#define TX_MIN_ARM 2
+
+typedef struct tx_entry_t {
+  tx_frame_t frame;
+  tx_output_t output;
+  volatile int handle;  // 0 marks a free entry
+  volatile size_t repeats;
+  uint16_t gap;
+  uint8_t priority;
+  bool notify;
+} tx_entry_t;
+
+/**
+ * A channel sends one entry at a time. It owns the output of the entry
+ * from the first edge to the end of the gap, so no other channel drives
+ * the same output meanwhile. All channels share the timer, which is armed
+ * for the earliest deadline.
+ */
+typedef struct tx_channel_t {
+  tx_entry_t *current;  // entry on air
+  int last;             // entry sent last
+  size_t index;         // of the next pulse
+  unsigned long schedule;  // of the next edge
+  unsigned long deadline;  // of the next event
+  uint32_t frame_error;
+  uint8_t burst;
+  bool active;  // deadline is valid
+  bool owned;   // output is in use
+  bool listening;
+  unsigned long listen_start;
+  tx_output_t output;
+} tx_channel_t;
+
+static tx_entry_t tx_queue[TX_QUEUE_SIZE];
+static tx_channel_t tx_channels[TX_CHANNELS];
+static volatile bool tx_running = false;
+static bool tx_timed = false;  // the timer is claimed
+static bool tx_footer = false;  // a footer was started
+static bool tx_keyed = false;
+static int tx_handle = 0;
+static TransmitStateCallBack tx_state = nullptr;
+
+static volatile int tx_done[TX_COMPLETED_SIZE];
+static volatile uint8_t tx_done_head = 0;
+static volatile uint8_t tx_done_tail = 0;
+
+static uint32_t tx_bucket_us[TX_AIRTIME_BUCKETS];
+static volatile uint8_t tx_bucket = 0;
+static unsigned long tx_bucket_start = 0;
+static volatile uint32_t tx_airtime_us = 0;
+static uint32_t tx_window_ms = 3600000;
+static uint32_t tx_limit_us = 0;
+
+static bool tx_precise = false;
+static tx_timing_t tx_stats = {};
+static const tx_backend_t *tx_backend = nullptr;
+
+static TransmitBusyCallBack tx_busy = nullptr;
+static uint16_t tx_listen_us = 0;
+static uint32_t tx_max_defer_us = 0;
+
+#ifdef ESP32
+static hw_timer_t *tx_timer = nullptr;
+#endif
+
+static unsigned long ICACHE_RAM_ATTR tx_now() {
+  return (tx_backend != nullptr) ? tx_backend->now() : micros();
+}
+
+static void ICACHE_RAM_ATTR tx_write(const tx_output_t *output,
+                                     uint8_t level) {
+  if (tx_backend != nullptr) {
+    tx_backend->write(output->pins[0], level);
+  } else {
+    output->write(output, level);
+  }
+}
+
+static void ICACHE_RAM_ATTR tx_write_gpio(const tx_output_t *output,
+                                          uint8_t level) {
+  for (uint8_t i = 0; i < output->count; i++) {
+    digitalWrite(output->pins[i], level);
+  }
+}
+
+#if defined(ESP8266) || defined(ESP32)
+static void ICACHE_RAM_ATTR tx_write_register(const tx_output_t *output,
+                                              uint8_t level) {
+#if defined(ESP8266)
+  if (level) {
+    GPOS = output->mask;
+  } else {
+    GPOC = output->mask;
+  }
+#else
+#ifdef GPIO_OUT1_W1TS_REG
+  if (output->bank != 0) {
+    REG_WRITE(level ? GPIO_OUT1_W1TS_REG : GPIO_OUT1_W1TC_REG, output->mask);
+    return;
+  }
+#endif
+  REG_WRITE(level ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, output->mask);
+#endif
+}
+#endif
+
+static bool ICACHE_RAM_ATTR tx_output_equal(const tx_output_t *a,
+                                            const tx_output_t *b) {
+  return a->write == b->write && a->arg == b->arg && a->mask == b->mask &&
+         a->bank == b->bank && a->count == b->count &&
+         (a->count == 0 || a->pins[0] == b->pins[0]);
+}
+
+/**
+ * Returns true, if a channel owns output.
+ */
+static bool ICACHE_RAM_ATTR tx_output_busy(const tx_output_t *output) {
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    if (tx_channels[c].owned &&
+        tx_output_equal(&tx_channels[c].output, output)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool ICACHE_RAM_ATTR tx_on_air(const tx_entry_t *entry) {
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    if (tx_channels[c].current == entry) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void ICACHE_RAM_ATTR tx_arm(uint16_t duration) {
+  if (tx_backend != nullptr) {
+    tx_backend->wait(duration);
+    return;
+  }
+#ifdef TRANSMITTER_ASYNC
+  if (tx_timed) {
+#if defined(ESP8266)
+    // TIM_DIV16: 5 ticks per microsecond
+    timer1_write((uint32_t)duration * 5);
+#else
+    timerWrite(tx_timer, 0);
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    timerAlarm(tx_timer, duration, false, 0);
+#else
+    timerAlarmWrite(tx_timer, duration, false);
+    timerAlarmEnable(tx_timer);
+#endif
+#endif
+    return;
+  }
+#endif
+  delayMicroseconds(duration);
+}
+
+/**
+ * Measure the error of the current edge of channel at now and return the
+ * largest error of the frame so far.
+ */
+static uint32_t ICACHE_RAM_ATTR tx_measure(tx_channel_t *channel,
+                                           unsigned long now) {
+  const int32_t error = (int32_t)(now - channel->schedule);
+  const uint32_t magnitude = (uint32_t)(error < 0 ? -error : error);
+  if (magnitude > channel->frame_error) {
+    channel->frame_error = magnitude;
+  }
+  return channel->frame_error;
+}
+
+/**
+ * Set the deadline of channel for the edge after the current one,
+ * duration after the schedule of the current edge. The first edge starts
+ * the schedule.
+ */
+static void ICACHE_RAM_ATTR tx_schedule(tx_channel_t *channel,
+                                        uint16_t duration, bool first) {
+  const unsigned long now = tx_now();
+  if (first) {
+    channel->schedule = now;
+    channel->frame_error = 0;
+  } else {
+    tx_measure(channel, now);
+  }
+  channel->schedule += duration;
+  channel->deadline = tx_precise ? channel->schedule : now + duration;
+  channel->active = true;
+}
+
+/**
+ * Account the timing of the frame of channel, which ended at the current
+ * edge.
+ */
+static void ICACHE_RAM_ATTR tx_account(tx_channel_t *channel) {
+  const unsigned long now = tx_now();
+  tx_stats.frames = tx_stats.frames + 1;
+  tx_stats.last_error = tx_measure(channel, now);
+  tx_stats.last_drift = (int32_t)(now - channel->schedule);
+  if (channel->frame_error > tx_stats.max_error) {
+    tx_stats.max_error = channel->frame_error;
+  }
+}
+
+static void ICACHE_RAM_ATTR tx_key(bool keyed) {
+  if (tx_keyed == keyed) {
+    return;
+  }
+  tx_keyed = keyed;
+  if (tx_state != nullptr) {
+    tx_state(keyed);
+  }
+}
+
+/**
+ * Unkey, if no channel is sending a frame.
+ */
+static void ICACHE_RAM_ATTR tx_unkey() {
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    if (tx_channels[c].current != nullptr) {
+      return;
+    }
+  }
+  tx_key(false);
+}
+
+static void ICACHE_RAM_ATTR tx_stop() {
+#if defined(ESP8266)
+  if (tx_timed) {
+    timer1_disable();
+  }
+#endif
+  tx_key(false);
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    tx_channel_t *channel = &tx_channels[c];
+    channel->current = nullptr;
+    channel->burst = 0;
+    channel->active = false;
+    channel->owned = false;
+    channel->listening = false;
+  }
+  tx_running = false;
+}
+
+/**
+ * Listen before a burst of channel. Returns true and sets the deadline, if
+ * the burst has to wait for the end of the listen period or of a
+ * reception.
+ */
+static bool ICACHE_RAM_ATTR tx_defer(tx_channel_t *channel) {
+  if (tx_listen_us == 0) {
+    return false;
+  }
+  const unsigned long now = tx_now();
+  if (!channel->listening) {
+    channel->listening = true;
+    channel->listen_start = now;
+  }
+  const uint32_t waited = now - channel->listen_start;
+  if (waited < tx_listen_us ||
+      (waited < tx_max_defer_us && tx_busy != nullptr && tx_busy(now))) {
+    channel->deadline = now + TX_LISTEN_STEP;
+    channel->active = true;
+    return true;
+  }
+  channel->listening = false;
+  return false;
+}
+
+/**
+ * Choose the entry for the next repeat of channel: the entry sent last
+ * while its burst lasts, otherwise the next entry with the highest
+ * priority (round robin), whose output is not used by another channel.
+ * Returns nullptr, if there is none or the airtime is used up.
+ */
+static tx_entry_t *ICACHE_RAM_ATTR tx_select(const tx_channel_t *channel) {
+  tx_entry_t *best = nullptr;
+
+  for (int n = 1; n <= TX_QUEUE_SIZE; n++) {
+    tx_entry_t *entry = &tx_queue[(channel->last + n) % TX_QUEUE_SIZE];
+    if (entry->handle != 0 &&
+        (best == nullptr || entry->priority > best->priority) &&
+        !tx_on_air(entry) && !tx_output_busy(&entry->output)) {
+      best = entry;
+    }
+  }
+  if (best == nullptr) {
+    return nullptr;
+  }
+  tx_entry_t *last = &tx_queue[channel->last];
+  if (channel->burst > 0 && last->handle != 0 &&
+      last->priority >= best->priority && !tx_on_air(last) &&
+      !tx_output_busy(&last->output)) {
+    best = last;
+  }
+  if (tx_limit_us != 0 &&
+      (uint64_t)tx_airtime_us + best->frame.duration > tx_limit_us) {
+    return nullptr;
+  }
+  return best;
+}
+
+static void ICACHE_RAM_ATTR tx_complete(tx_entry_t *entry) {
+  if (entry->notify) {
+    tx_done[tx_done_head] = entry->handle;
+    tx_done_head = (uint8_t)((tx_done_head + 1) % TX_COMPLETED_SIZE);
+    if (tx_done_head == tx_done_tail) {
+      // drop the oldest handle
+      tx_done_tail = (uint8_t)((tx_done_tail + 1) % TX_COMPLETED_SIZE);
+    }
+  }
+  entry->handle = 0;
+}
+
+/**
+ * Handle the event of channel: output the next edge and set the deadline
+ * for its duration. Even pulses are high, odd pulses are low. After every
+ * repeat the airtime is accounted and, after the gap, the next entry is
+ * selected.
+ */
+static void ICACHE_RAM_ATTR tx_channel_step(tx_channel_t *channel) {
+  tx_entry_t *entry = channel->current;
+  if (entry != nullptr) {
+    const size_t i = channel->index;
+    if (i < entry->frame.length) {
+      channel->index = i + 1;
+      if (i == 0) {
+        tx_key(true);
+      }
+      tx_write(&channel->output, (i & 1) ? LOW : HIGH);
+      tx_schedule(channel, tx_frame_pulse(&entry->frame, i), i == 0);
+      tx_footer = tx_footer || i + 1 == entry->frame.length;
+      return;
+    }
+    tx_write(&channel->output, LOW);
+    tx_account(channel);
+    tx_bucket_us[tx_bucket] += entry->frame.duration;
+    tx_airtime_us = tx_airtime_us + entry->frame.duration;
+    channel->burst = channel->burst - 1;
+    channel->last = (int)(entry - tx_queue);
+    channel->current = nullptr;
+    const uint16_t gap = entry->gap;
+    if (entry->repeats <= 1) {
+      tx_complete(entry);
+    } else {
+      entry->repeats = entry->repeats - 1;
+    }
+    if (gap > 0) {
+      tx_unkey();
+      channel->deadline = tx_now() + gap;
+      return;
+    }
+  }
+  channel->owned = false;
+  channel->active = false;
+  tx_entry_t *next = tx_select(channel);
+  if (next == nullptr) {
+    channel->listening = false;
+    tx_unkey();
+    return;
+  }
+  if (next != &tx_queue[channel->last] || channel->burst == 0) {
+    if (tx_defer(channel)) {
+      tx_unkey();
+      return;
+    }
+    channel->burst = TX_QUEUE_BURST;
+  }
+  channel->current = next;
+  channel->index = 0;
+  channel->output = next->output;
+  channel->owned = true;
+  tx_channel_step(channel);
+}
+
+/**
+ * Handle the channels, which are due or idle, and arm the timer for the
+ * earliest deadline.
+ */
+static void ICACHE_RAM_ATTR tx_step() {
+  const unsigned long now = tx_now();
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    tx_channel_t *channel = &tx_channels[c];
+    if (!channel->active ||
+        (int32_t)(channel->deadline - now) <= TX_MIN_ARM) {
+      tx_channel_step(channel);
+    }
+  }
+  const tx_channel_t *next = nullptr;
+  for (uint8_t c = 0; c < TX_CHANNELS; c++) {
+    const tx_channel_t *channel = &tx_channels[c];
+    if (channel->active &&
+        (next == nullptr ||
+         (int32_t)(channel->deadline - next->deadline) < 0)) {
+      next = channel;
+    }
+  }
+  if (next == nullptr) {
+    tx_stop();
+    return;
+  }
+  if (tx_footer && !tx_timed && tx_backend == nullptr) {
+    // blocking transmissions yield between repeats, during the footer, as
+    // the deadline of its end is already set
+    tx_footer = false;
+    yield();
+  }
+  const int32_t remaining = (int32_t)(next->deadline - tx_now());
+  tx_arm((uint16_t)std::min<int32_t>(std::max<int32_t>(remaining, TX_MIN_ARM),
+                                     std::numeric_limits<uint16_t>::max()));
+}
+
+static void tx_init() {
+#if defined(ESP8266)
+  timer1_isr_init();
+  timer1_attachInterrupt(tx_step);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+#elif defined(ESP32)
+  if (tx_timer == nullptr) {
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+    tx_timer = timerBegin(1000000);
+    timerAttachInterrupt(tx_timer, tx_step);
+#else
+    tx_timer = timerBegin(0, 80, true);
+    timerAttachInterrupt(tx_timer, tx_step, true);
+#endif
+  }
+#endif
+}
+
+/**
+ * Start the transmitter, if it is idle and an entry may be sent.
+ */
+static void tx_kick() {
+  if (tx_running || tx_select(&tx_channels[0]) == nullptr) {
+    return;
+  }
+  tx_running = true;
+  if (tx_backend == nullptr && tx_timed) {
+    tx_init();
+    tx_step();
+    return;
+  }
+  while (tx_running) {
+    tx_step();
+  }
+}
+
+void tx_output_gpio(tx_output_t *output, const uint8_t *pins, size_t count) {
+  output->write = tx_write_gpio;
+  output->arg = nullptr;
+  output->mask = 0;
+  output->bank = 0;
+  output->count = (uint8_t)std::min<size_t>(count, TX_OUTPUT_PINS);
+  for (uint8_t i = 0; i < output->count; i++) {
+    output->pins[i] = pins[i];
+    pinMode(pins[i], OUTPUT);
+    digitalWrite(pins[i], LOW);
+  }
+}
+
+bool tx_output_register(tx_output_t *output, const uint8_t *pins,
+                        size_t count) {
+  tx_output_gpio(output, pins, count);
+#if defined(ESP8266) || defined(ESP32)
+  uint32_t mask = 0;
+  const uint8_t bank = (output->count > 0) ? pins[0] / 32 : 0;
+  for (uint8_t i = 0; i < output->count; i++) {
+#if defined(ESP8266)
+    // GPIO16 has its own register
+    if (pins[i] >= 16) {
+      return false;
+    }
+#elif !defined(GPIO_OUT1_W1TS_REG)
+    if (pins[i] >= 32) {
+      return false;
+    }
+#endif
+    if (pins[i] / 32 != bank) {
+      return false;
+    }
+    mask |= 1UL << (pins[i] % 32);
+  }
+  output->write = tx_write_register;
+  output->mask = mask;
+  output->bank = bank;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Pack pulses with the given tolerance. Returns false, if more than
+ * TX_PULSE_TYPES types are needed.
+ */
+static bool tx_frame_pack(tx_frame_t *frame, const uint16_t *pulses,
+                          size_t length, uint32_t tolerance,
+                          uint32_t *deviation) {
+  uint8_t nrtypes = 0;
+
+  *deviation = 0;
+  frame->duration = 0;
+  for (size_t i = 0; i < length; i++) {
+    uint8_t type = 0;
+    uint32_t diff = 0;
+    for (; type < nrtypes; type++) {
+      diff = (uint32_t)abs((int32_t)frame->types[type] - (int32_t)pulses[i]);
+      if (diff <= tolerance) {
+        break;
+      }
+    }
+    if (type == nrtypes) {
+      if (nrtypes == TX_PULSE_TYPES) {
+        return false;
+      }
+      frame->types[nrtypes++] = pulses[i];
+      diff = 0;
+    }
+    if (i & 1) {
+      frame->symbols[i >> 1] |= (uint8_t)(type << 4);
+    } else {
+      frame->symbols[i >> 1] = type;
+    }
+    frame->duration += frame->types[type];
+    *deviation = std::max(*deviation, diff);
+  }
+  for (uint8_t type = nrtypes; type < TX_PULSE_TYPES; type++) {
+    frame->types[type] = 0;
+  }
+  frame->length = (uint16_t)length;
+  return true;
+}
+
+uint32_t tx_frame_encode(tx_frame_t *frame, const uint16_t *pulses,
+                         size_t length) {
+  uint32_t tolerance = 0;
+  uint32_t deviation = 0;
+
+  if (length > MAXPULSESTREAMLENGTH) {
+    length = MAXPULSESTREAMLENGTH;
+  }
+  while (!tx_frame_pack(frame, pulses, length, tolerance, &deviation)) {
+    tolerance = (tolerance == 0) ? 25 : tolerance * 2;
+  }
+  return deviation;
+}
+
+size_t tx_frame_decode(const tx_frame_t *frame, uint16_t *pulses) {
+  for (size_t i = 0; i < frame->length; i++) {
+    pulses[i] = tx_frame_pulse(frame, i);
+  }
+  return frame->length;
+}
+
+int tx_enqueue(const tx_output_t *output, const tx_frame_t *frame,
+               size_t repeats, uint8_t priority, uint16_t gap, bool notify) {
+  int slot = -1;
+
+  for (int i = 0; i < TX_QUEUE_SIZE; i++) {
+    if (tx_queue[i].handle == 0 && !tx_on_air(&tx_queue[i])) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    return -1;
+  }
+  tx_entry_t *entry = &tx_queue[slot];
+  // copy the used symbols only
+  memcpy(&entry->frame, frame,
+         offsetof(tx_frame_t, symbols) + (frame->length + 1) / 2);
+  entry->repeats = repeats;
+  entry->gap = gap;
+  entry->priority = priority;
+  entry->output = *output;
+  entry->notify = notify;
+  tx_handle = (tx_handle % std::numeric_limits<int16_t>::max()) + 1;
+  const int handle = tx_handle;
+  if (frame->length == 0 || repeats == 0) {
+    noInterrupts();
+    entry->handle = handle;
+    tx_complete(entry);
+    interrupts();
+    return handle;
+  }
+#ifdef TRANSMITTER_ASYNC
+  tx_timed = tx_timed || notify;
+#endif
+  entry->handle = handle;
+  tx_poll();
+  return handle;
+}
+
+bool tx_pending(int handle) {
+  for (int i = 0; i < TX_QUEUE_SIZE; i++) {
+    if (tx_queue[i].handle != 0 &&
+        (handle == 0 || tx_queue[i].handle == handle)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int tx_completed() {
+  int handle = 0;
+
+  noInterrupts();
+  if (tx_done_tail != tx_done_head) {
+    handle = tx_done[tx_done_tail];
+    tx_done_tail = (uint8_t)((tx_done_tail + 1) % TX_COMPLETED_SIZE);
+  }
+  interrupts();
+  return handle;
+}
+
+void tx_abort(int handle) {
+  noInterrupts();
+  for (int i = 0; i < TX_QUEUE_SIZE; i++) {
+    tx_entry_t *entry = &tx_queue[i];
+    if (entry->handle == 0 || (handle != 0 && entry->handle != handle)) {
+      continue;
+    }
+    if (tx_on_air(entry)) {
+      entry->repeats = 1;
+    } else {
+      tx_complete(entry);
+    }
+  }
+  interrupts();
+}
+
+void tx_poll() {
+  const unsigned long now = millis();
+  const uint32_t length = std::max<uint32_t>(
+      tx_window_ms / TX_AIRTIME_BUCKETS, 1);
+
+  if (now - tx_bucket_start >= tx_window_ms + length) {
+    // idle for longer than the window
+    noInterrupts();
+    for (uint8_t i = 0; i < TX_AIRTIME_BUCKETS; i++) {
+      tx_bucket_us[i] = 0;
+    }
+    tx_airtime_us = 0;
+    interrupts();
+    tx_bucket_start = now;
+  }
+  while (now - tx_bucket_start >= length) {
+    noInterrupts();
+    tx_bucket = (uint8_t)((tx_bucket + 1) % TX_AIRTIME_BUCKETS);
+    tx_airtime_us = tx_airtime_us - tx_bucket_us[tx_bucket];
+    tx_bucket_us[tx_bucket] = 0;
+    interrupts();
+    tx_bucket_start += length;
+  }
+  tx_kick();
+}
+
+void tx_set_duty_cycle(uint16_t permille, uint32_t window_ms) {
+  // window_ms * 1000 us * permille / 1000, the airtime is counted in 32 bit
+  tx_limit_us = (uint32_t)std::min<uint64_t>(
+      (uint64_t)window_ms * permille, std::numeric_limits<uint32_t>::max());
+  tx_window_ms = window_ms;
+}
+
+uint32_t tx_airtime() { return tx_airtime_us; }
+
+void tx_set_precise(bool precise) { tx_precise = precise; }
+
+tx_timing_t tx_timing(bool reset) {
+  noInterrupts();
+  const tx_timing_t timing = tx_stats;
+  if (reset) {
+    tx_stats = {};
+  }
+  interrupts();
+  return timing;
+}
+
+void tx_set_backend(const tx_backend_t *backend) { tx_backend = backend; }
+
+unsigned long tx_micros() { return tx_now(); }
+
+void tx_set_listen(TransmitBusyCallBack busy, uint16_t listen_us,
+                   uint32_t max_defer_us) {
+  tx_busy = busy;
+  tx_listen_us = listen_us;
+  tx_max_defer_us = max_defer_us;
+}
+
+void tx_set_state_callback(TransmitStateCallBack callback) {
+  tx_state = callback;
+}
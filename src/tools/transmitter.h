@@ -0,0 +1,249 @@
+/*
+  ESPiLight - pilight 433.92 MHz protocols library for Arduino
+  Copyright (c) 2016 Puuu.  All right reserved.
+
+  Project home: https://github.com/puuu/espilight/
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _TRANSMITTER_H_
+#define _TRANSMITTER_H_
+
+#include <Arduino.h>
+
+// Entries queued with notify are transmitted asynchronously, driven by
+// timer1 on ESP8266 and by hardware timer 0 on ESP32. The first of them
+// claims the timer for good. Until then, and elsewhere, the queue is
+// transmitted blocking with delayMicroseconds() and no timer is used.
+#if defined(ESP8266) || defined(ESP32)
+#define TRANSMITTER_ASYNC
+#endif
+
+#ifndef TX_QUEUE_SIZE
+#define TX_QUEUE_SIZE 8
+#endif
+
+// Number of repeats of an entry sent back to back, before the next entry of
+// the same priority gets its turn.
+#ifndef TX_QUEUE_BURST
+#define TX_QUEUE_BURST 2
+#endif
+
+// Number of entries sent concurrently, each on its own output
+#ifndef TX_CHANNELS
+#define TX_CHANNELS 2
+#endif
+
+// Number of pins an output drives with the same signal
+#ifndef TX_OUTPUT_PINS
+#define TX_OUTPUT_PINS 4
+#endif
+
+// Resolution of the rolling airtime window
+#define TX_AIRTIME_BUCKETS 16
+
+// Interval in microseconds in which a deferred burst polls the receiver
+#define TX_LISTEN_STEP 250
+
+#ifndef MAXPULSESTREAMLENGTH
+#define MAXPULSESTREAMLENGTH 255
+#endif
+
+// Number of pulse types of a frame, one type index takes 4 bit
+#define TX_PULSE_TYPES 16
+
+/**
+ * Compact pulse train, like the c:/p: string format: a table of pulse
+ * types and a 4 bit type index per pulse (even pulses in the low nibble).
+ * It takes about a third of a plain pulse train and is expanded by the
+ * transmitter while sending.
+ */
+typedef struct tx_frame_t {
+  uint16_t types[TX_PULSE_TYPES];
+  uint32_t duration;  // of all pulses in microseconds
+  uint16_t length;
+  uint8_t symbols[(MAXPULSESTREAMLENGTH + 1) / 2];
+} tx_frame_t;
+
+/**
+ * Timing of the transmitted frames, measured at every edge against the
+ * schedule from the first edge of the frame.
+ */
+typedef struct tx_timing_t {
+  uint32_t frames;      // since the last reset
+  uint32_t last_error;  // largest edge error of the last frame in us
+  int32_t last_drift;   // end of the last frame against the schedule in us
+  uint32_t max_error;   // largest edge error of all frames in us
+} tx_timing_t;
+
+typedef struct tx_output_t tx_output_t;
+typedef void (*TransmitOutputWrite)(const tx_output_t *output, uint8_t level);
+
+/**
+ * Output driver of a transmitter: write(output, level) sets all pins of
+ * the output to level. It is called from the timer interrupt and must be
+ * placed in IRAM. arg, mask and bank are free for the driver.
+ */
+struct tx_output_t {
+  TransmitOutputWrite write;
+  void *arg;
+  uint32_t mask;  // of the pins within their register
+  uint8_t bank;   // register of the pins
+  uint8_t count;
+  uint8_t pins[TX_OUTPUT_PINS];
+};
+
+typedef void (*TransmitStateCallBack)(bool active);
+typedef bool (*TransmitBusyCallBack)(unsigned long now);
+
+/**
+ * Clock, timing and output of the transmitter. A backend is blocking:
+ * wait() returns after the time has elapsed, e.g. on a virtual clock.
+ */
+typedef struct tx_backend_t {
+  unsigned long (*now)();  // in microseconds
+  void (*wait)(uint16_t duration);
+  void (*write)(uint8_t pin, uint8_t level);
+} tx_backend_t;
+
+/**
+ * Initialize output to drive count pins (at most TX_OUTPUT_PINS) with
+ * digitalWrite(). The pins are configured as outputs and set low.
+ */
+void tx_output_gpio(tx_output_t *output, const uint8_t *pins, size_t count);
+
+/**
+ * Initialize output to drive count pins with a single write to the set and
+ * clear registers of the ESP8266 (GPIO 0-15) or ESP32, so all pins switch
+ * at the same time. Returns false and falls back to tx_output_gpio(), if
+ * the pins are not in one register or the platform is not supported.
+ */
+bool tx_output_register(tx_output_t *output, const uint8_t *pins,
+                        size_t count);
+
+/**
+ * Pack length pulses into frame. Pulses share a type, if they differ by no
+ * more than a tolerance, which starts at 0 and is increased until the
+ * pulses fit into TX_PULSE_TYPES types.
+ * Returns the largest deviation of a pulse in microseconds, 0 if the frame
+ * is exact.
+ */
+uint32_t tx_frame_encode(tx_frame_t *frame, const uint16_t *pulses,
+                         size_t length);
+
+/**
+ * Unpack frame into pulses (MAXPULSESTREAMLENGTH). Returns the length.
+ */
+size_t tx_frame_decode(const tx_frame_t *frame, uint16_t *pulses);
+
+/**
+ * Duration of pulse i of frame.
+ */
+static inline uint16_t tx_frame_pulse(const tx_frame_t *frame, size_t i) {
+  return frame->types[(frame->symbols[i >> 1] >> ((i & 1) << 2)) & 0xf];
+}
+
+/**
+ * Queue a frame to be transmitted repeats times on output. The frame and
+ * the output are copied. Entries with higher priority are sent first,
+ * repeats of entries with equal priority are interleaved. gap is an
+ * additional low time (in microseconds) after every repeat. Entries on
+ * different outputs are sent concurrently on up to TX_CHANNELS channels,
+ * outputs sharing a pin must be equal. Only handles of entries queued with
+ * notify are returned by tx_completed(), see TRANSMITTER_ASYNC for the
+ * timer they use.
+ * Returns a handle (> 0) or -1, if the queue is full.
+ */
+int tx_enqueue(const tx_output_t *output, const tx_frame_t *frame,
+               size_t repeats, uint8_t priority, uint16_t gap, bool notify);
+
+/**
+ * Returns true while the entry of handle (or any entry, if handle is 0) is
+ * queued or transmitted.
+ */
+bool tx_pending(int handle);
+
+/**
+ * Returns the handle of a completed entry, or 0 if there is none. Every
+ * handle is returned once.
+ */
+int tx_completed();
+
+/**
+ * Drop the entry of handle (or all entries, if handle is 0). A frame which
+ * is on air is completed first. Dropped entries are completed like sent
+ * ones, see tx_completed().
+ */
+void tx_abort(int handle);
+
+/**
+ * Must be called regularly. Advances the airtime window and restarts the
+ * transmitter, when it was paused by the duty cycle limit.
+ */
+void tx_poll();
+
+/**
+ * Limit the airtime to permille of a rolling window of window_ms. A
+ * permille of 0 (default) disables the limit. Limits above 2^32 - 1 us
+ * (about 71 minutes) are clamped.
+ */
+void tx_set_duty_cycle(uint16_t permille, uint32_t window_ms);
+
+/**
+ * Airtime in microseconds used within the rolling window.
+ */
+uint32_t tx_airtime();
+
+/**
+ * If precise is true, every edge is timed against an absolute deadline
+ * (start of the frame plus the preceding pulses) instead of the pulse
+ * duration, so the time taken by the output and by other interrupts does
+ * not add up along the frame.
+ */
+void tx_set_precise(bool precise);
+
+/**
+ * Returns the timing of the transmitted frames. reset clears it.
+ */
+tx_timing_t tx_timing(bool reset);
+
+/**
+ * Replace micros(), the hardware timer and the output drivers by backend,
+ * or restore them, if backend is nullptr. backend->write() is called with
+ * the first pin of the output. Must not be changed while transmitting.
+ */
+void tx_set_backend(const tx_backend_t *backend);
+
+/**
+ * Current time of the transmitter clock in microseconds, i.e. micros() or
+ * the time of the backend.
+ */
+unsigned long tx_micros();
+
+/**
+ * Listen before every burst of repeats: the channel stays unkeyed for
+ * listen_us and defers the burst while busy(now) returns true, for at most
+ * max_defer_us. A listen_us of 0 (default) disables it.
+ */
+void tx_set_listen(TransmitBusyCallBack busy, uint16_t listen_us,
+                   uint32_t max_defer_us);
+
+/**
+ * callback is called with true when the transmitter starts keying a frame
+ * and with false when no channel is keying anymore, because of a gap, a
+ * listen period or because it becomes idle, possibly from the timer
+ * interrupt.
+ */
+void tx_set_state_callback(TransmitStateCallBack callback);
+
+#endif  //_TRANSMITTER_H_
@@ -0,0 +1,81 @@
+/*
+ Basic ESPiLight adaptive timing test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define PROTOCOL "arctech_switch"
+#define JMESSAGE "{\"id\":1234,\"unit\":1,\"on\":1}"
+
+ESPiLight rf(-1);  // use -1 to disable transmitter
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  Serial.print("parsed message [");
+  Serial.print(protocol);  // protocol used to parse
+  Serial.print("][");
+  Serial.print(deviceID);  // value of id key in json message
+  Serial.print("] (");
+  Serial.print(status);
+  Serial.print(") ");
+  Serial.print(message);  // message in json format
+  Serial.println();
+}
+
+void parseDrifted(const uint16_t *pulses, int length, int percent) {
+  uint16_t drifted[MAXPULSESTREAMLENGTH];
+  for (int i = 0; i < length; i++) {
+    drifted[i] = (uint16_t)((uint32_t)pulses[i] * percent / 100);
+  }
+  Serial.print("clock at ");
+  Serial.print(percent);
+  Serial.print(" %, matches: ");
+  Serial.println(rf.parsePulseTrain(drifted, (uint8_t)length));
+}
+
+// only the data pulses drift, the footer is kept
+void parseDataDrifted(const uint16_t *pulses, int length, int percent) {
+  uint16_t drifted[MAXPULSESTREAMLENGTH];
+  for (int i = 0; i + 1 < length; i++) {
+    drifted[i] = (uint16_t)((uint32_t)pulses[i] * percent / 100);
+  }
+  drifted[length - 1] = pulses[length - 1];
+  Serial.print("data pulses at ");
+  Serial.print(percent);
+  Serial.print(" %, matches: ");
+  Serial.println(rf.parsePulseTrain(drifted, (uint8_t)length));
+}
+
+void setup() {
+  Serial.begin(115200);
+  // set callback funktion
+  rf.setCallback(rfCallback);
+  rf.limitProtocols("[\"" PROTOCOL "\"]");
+
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  int length = rf.createPulseTrain(pulses, PROTOCOL, JMESSAGE);
+
+  Serial.println(
+      "Without adaptive timing (only 100 % and data pulses at 120 % should "
+      "match):");
+  parseDrifted(pulses, length, 70);
+  parseDrifted(pulses, length, 100);
+  parseDrifted(pulses, length, 115);
+  parseDataDrifted(pulses, length, 65);
+  parseDataDrifted(pulses, length, 120);
+
+  rf.setAdaptiveTimingEnabled(true);
+  Serial.println("With adaptive timing (all should match):");
+  parseDrifted(pulses, length, 70);
+  parseDrifted(pulses, length, 100);
+  parseDrifted(pulses, length, 115);
+  parseDataDrifted(pulses, length, 65);
+  parseDataDrifted(pulses, length, 120);
+}
+
+void loop() {
+  // nothing
+}
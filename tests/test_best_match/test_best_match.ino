@@ -0,0 +1,48 @@
+/*
+ Basic ESPiLight best match test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define PROTOCOL "elro_800_switch"
+#define JMESSAGE "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"
+
+ESPiLight rf(-1);  // use -1 to disable transmitter
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  Serial.print("parsed message [");
+  Serial.print(protocol);  // protocol used to parse
+  Serial.print("][");
+  Serial.print(deviceID);  // value of id key in json message
+  Serial.print("] (confidence ");
+  Serial.print(rf.confidence());  // how well the pulse train fits protocol
+  Serial.print(") ");
+  Serial.print(message);  // message in json format
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+  // set callback funktion
+  rf.setCallback(rfCallback);
+
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  int length = rf.createPulseTrain(pulses, PROTOCOL, JMESSAGE);
+
+  Serial.println("All interpretations:");
+  Serial.print("matches: ");
+  Serial.println(rf.parsePulseTrain(pulses, (uint8_t)length));
+
+  rf.setBestMatchEnabled(true);
+  Serial.println("Best interpretation only:");
+  Serial.print("matches (should be 1): ");
+  Serial.println(rf.parsePulseTrain(pulses, (uint8_t)length));
+}
+
+void loop() {
+  // nothing
+}
@@ -0,0 +1,65 @@
+/*
+ Basic ESPiLight registered command test: the cache keeps one entry, which
+ is not pinned, for send()
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define TRANSMITTER_PIN 13
+#define PROTOCOL "pollin"
+
+ESPiLight rf(TRANSMITTER_PIN);
+
+String message(int unitcode) {
+  String json = "{\"systemcode\":17,\"unitcode\":";
+  json += unitcode;
+  json += ",\"on\":1}";
+  return json;
+}
+
+void printResult(const char *what, int result) {
+  Serial.print(what);
+  Serial.print(": ");
+  Serial.println(result);
+}
+
+void setup() {
+  Serial.begin(115200);
+  // complete transmissions at once, without hardware
+  ESPiLight::beginSimulation(nullptr, 0);
+
+  int commands[TX_CACHE_SIZE - 1];
+  for (int i = 0; i < TX_CACHE_SIZE - 1; i++) {
+    commands[i] = ESPiLight::registerCommand(PROTOCOL, message(i));
+    printResult("register", commands[i]);
+  }
+  // all entries but one are pinned
+  printResult("register new",
+              ESPiLight::registerCommand(PROTOCOL, message(20)));
+
+  // the last entry is taken by send() and must not be pinned afterwards
+  printResult("send", rf.send(PROTOCOL, message(21), 1));
+  printResult("register sent",
+              ESPiLight::registerCommand(PROTOCOL, message(21)));
+  printResult("send other", rf.send(PROTOCOL, message(22), 1));
+  printResult("send again", rf.send(PROTOCOL, message(21), 1));
+
+  // a registered command is a hit and may be registered again
+  printResult("register again",
+              ESPiLight::registerCommand(PROTOCOL, message(0)));
+  printResult("send command", rf.sendCommand(commands[0], 1));
+
+  // a released entry can be taken again
+  ESPiLight::releaseCommand(commands[1]);
+  printResult("register after release",
+              ESPiLight::registerCommand(PROTOCOL, message(21)));
+  printResult("send after release", rf.send(PROTOCOL, message(23), 1));
+
+  ESPiLight::endSimulation();
+}
+
+void loop() {
+  // nothing
+}
@@ -0,0 +1,82 @@
+/*
+ Basic ESPiLight compact pulse train test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define TRANSMITTER_PIN 13
+
+#define PROTOCOL "arctech_switch"
+#define JMESSAGE "{\"id\":1234,\"unit\":1,\"on\":1}"
+
+ESPiLight rf(TRANSMITTER_PIN);
+
+void compareExpanded(const CompactPulseTrain_t *frame, const uint16_t *pulses,
+                     size_t length) {
+  uint16_t expanded[MAXPULSESTREAMLENGTH];
+  size_t expandedLength = ESPiLight::expandPulseTrain(frame, expanded);
+  uint16_t deviation = 0;
+  for (size_t i = 0; i < length && i < expandedLength; i++) {
+    uint16_t diff = expanded[i] > pulses[i] ? expanded[i] - pulses[i]
+                                            : pulses[i] - expanded[i];
+    if (diff > deviation) {
+      deviation = diff;
+    }
+  }
+  Serial.print("expanded length: ");
+  Serial.print(expandedLength);
+  Serial.print(", largest deviation: ");
+  Serial.println(deviation);
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  CompactPulseTrain_t frame;
+  uint32_t deviation = 0;
+
+  Serial.print("size of pulse train: ");
+  Serial.print(sizeof(pulses));
+  Serial.print(", compact: ");
+  Serial.println(sizeof(frame));
+
+  // protocol pulse trains use a few exact pulse types
+  int length = ESPiLight::createPulseTrain(pulses, PROTOCOL, JMESSAGE);
+  Serial.print("arctech_switch pulses: ");
+  Serial.print(length);
+  Serial.print(", packed (should be the length): ");
+  Serial.print(
+      ESPiLight::compressPulseTrain(&frame, pulses, length, &deviation));
+  Serial.print(", deviation (should be 0): ");
+  Serial.println(deviation);
+  compareExpanded(&frame, pulses, length);
+  Serial.println(ESPiLight::pulseTrainToString(pulses, length));
+
+  // raw pulse trains are sent exactly or not at all
+  ESPiLight::beginSimulation(nullptr, 0);
+  Serial.print("sent exact pulses: ");
+  Serial.println(rf.sendPulseTrain(pulses, length, 1));
+
+  // received raw code with jitter, pulse types are merged
+  for (int i = 0; i < length; i++) {
+    pulses[i] = pulses[i] + (uint16_t)((i * 37) % 61) - 30;
+  }
+  Serial.print("jittered packed (should be ERROR_INEXACT_PULSETRAIN): ");
+  Serial.print(
+      ESPiLight::compressPulseTrain(&frame, pulses, length, &deviation));
+  Serial.print(", deviation (should be below 100): ");
+  Serial.println(deviation);
+  compareExpanded(&frame, pulses, length);
+  Serial.print("sent jittered pulses (should be ERROR_INEXACT_PULSETRAIN): ");
+  Serial.println(rf.sendPulseTrain(pulses, length, 1));
+  Serial.print("simulated edges: ");
+  Serial.println(ESPiLight::simulatedEdges());
+  ESPiLight::endSimulation();
+}
+
+void loop() {
+  // nothing
+}
@@ -0,0 +1,79 @@
+/*
+ Basic ESPiLight device settings test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define PROTOCOL "nexus"
+#define DEVICES                                                    \
+  "{\"outside\":{\"protocol\":[\"" PROTOCOL "\"],\"id\":[{\"id\":42}]," \
+  "\"temperature-offset\":-1.5,\"humidity-offset\":2}}"
+
+ESPiLight rf(-1);  // use -1 to disable transmitter
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  Serial.print("parsed message [");
+  Serial.print(protocol);  // protocol used to parse
+  Serial.print("][");
+  Serial.print(deviceID);  // value of id key in json message
+  Serial.print("] (");
+  Serial.print(status);
+  Serial.print(") ");
+  Serial.print(message);  // message in json format
+  Serial.println();
+}
+
+// nexus frame: id 42, channel 1, 21.5 degree celsius, 60 % humidity
+size_t createNexusPulseTrain(uint16_t *pulses) {
+  // {value, number of bits}: id, battery, 0, channel, temperature, 1111,
+  // humidity
+  const uint16_t fields[][2] = {{42, 8},  {1, 1},  {0, 1}, {1, 2},
+                                {215, 12}, {15, 4}, {60, 8}};
+  size_t length = 0;
+  for (unsigned int f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+    const uint16_t value = fields[f][0];
+    for (int b = fields[f][1] - 1; b >= 0; b--) {
+      pulses[length++] = 500;
+      pulses[length++] = ((value >> b) & 1) ? 2000 : 1000;
+    }
+  }
+  pulses[length++] = 500;
+  pulses[length++] = 4000;
+  return length;
+}
+
+void setup() {
+  Serial.begin(115200);
+  // set callback funktion
+  rf.setCallback(rfCallback);
+
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  size_t length = createNexusPulseTrain(pulses);
+  rf.limitProtocols("[\"" PROTOCOL "\"]");
+
+  Serial.println("Without device settings:");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+
+  // load temperature and humidity offsets
+  Serial.print("Loaded devices (should be 1): ");
+  Serial.println(rf.loadDevices(DEVICES));
+  Serial.println("With device settings (20.0 degree, 62 %):");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+
+  // invalid json is rejected
+  Serial.print("Loaded devices (should be -2): ");
+  Serial.println(rf.loadDevices("{\"outside\":"));
+
+  // drop settings again
+  rf.clearDevices();
+  Serial.println("After clearing device settings:");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+}
+
+void loop() {
+  // nothing
+}
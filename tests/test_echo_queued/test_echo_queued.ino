@@ -0,0 +1,88 @@
+/*
+ Basic ESPilight echo verification test of a queued transmission
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define TRANSMITTER_PIN 13
+
+const char *const protocol = "elro_800_switch";
+const char *const message = "{\"systemcode\":17,\"unitcode\":1,\"on\":1}";
+
+ESPiLight rf(TRANSMITTER_PIN);
+size_t received = 0;
+int completed = 0;
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  received++;
+}
+
+// callback function. It is called with the handle of every completed
+// asynchronous transmission
+void txCallback(int handle) { completed = handle; }
+
+void sendQueued() {
+  // the echo of this transmission is not yet processed by loop()
+  rf.setEchoVerification(0);
+  const int length = rf.send(protocol, message, 1);
+  Serial.print("sent ");
+  Serial.print(length);
+  Serial.print(" pulses, ");
+  Serial.print(ESPiLight::airtime());
+  Serial.println(" us airtime");
+
+  // the airtime is used up, so the next transmission stays queued
+  ESPiLight::setDutyCycle(1, 10000);
+  rf.setEchoVerification(1);
+  received = 0;
+  completed = 0;
+  const int handle = rf.sendAsync(protocol, message, 3);
+  Serial.print("queued: ");
+  Serial.println(rf.transmitting(handle) ? "yes" : "no");
+
+  // the echo verifies the queued transmission, which is dropped
+  rf.loop();
+  Serial.print("queued: ");
+  Serial.println(rf.transmitting(handle) ? "yes" : "no");
+  Serial.print("received ");
+  Serial.print(received);
+  Serial.println(" messages");
+  Serial.print("completed: ");
+  Serial.println(completed == handle ? "yes" : "no");
+  const EchoStats_t stats = ESPiLight::echoStats(protocol);
+  Serial.print("verified ");
+  Serial.print(stats.confirmed);
+  Serial.print(" of ");
+  Serial.print(stats.transmissions);
+  Serial.print(" transmissions, ");
+  Serial.print(stats.echoes);
+  Serial.println(" echoes");
+  ESPiLight::setDutyCycle(0);
+}
+
+void setup() {
+  Serial.begin(115200);
+  rf.setCallback(rfCallback);
+  rf.setTransmitCallback(txCallback);
+  // the loopback is received like the echo of a real transmitter
+  ESPiLight::enableReceiver();
+  rf.setEchoEnabled(true);
+  ESPiLight::beginSimulation(nullptr, 0, nullptr, true);
+
+  sendQueued();
+
+  // echoes are verified without a callback for received messages
+  Serial.println("Without callback:");
+  rf.setCallback(nullptr);
+  sendQueued();
+
+  ESPiLight::endSimulation();
+}
+
+void loop() {
+  // nothing
+}
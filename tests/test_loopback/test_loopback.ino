@@ -0,0 +1,99 @@
+/*
+ Basic ESPiLight simulated transmitter loopback test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define TRANSMITTER_PIN 13
+#define REPEATS 3
+
+const char *const messages[][2] = {
+    {"elro_800_switch", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+    {"elro_400_switch", "{\"systemcode\":17,\"unitcode\":1,\"off\":1}"},
+    {"pollin", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+};
+
+ESPiLight rf(TRANSMITTER_PIN);
+SimulatedEdge_t edges[8];
+const char *sent = nullptr;
+String first;
+size_t received = 0;
+size_t decoded = 0;
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  decoded++;
+  // several protocols may decode the same pulse train
+  if (protocol == sent) {
+    if (received == 0) {
+      first = message;
+    }
+    received++;
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  rf.setCallback(rfCallback);
+  // the loopback is received like the echo of a real transmitter
+  ESPiLight::enableReceiver();
+  rf.setEchoEnabled(true);
+  // match the echoes against the sent messages
+  rf.setEchoVerification(REPEATS);
+  ESPiLight::beginSimulation(edges, sizeof(edges) / sizeof(edges[0]), nullptr,
+                             true);
+
+  for (unsigned int m = 0; m < sizeof(messages) / sizeof(messages[0]); m++) {
+    const uint32_t start = ESPiLight::simulationTime();
+    const size_t recorded = ESPiLight::simulatedEdges();
+    sent = messages[m][0];
+    first = "";
+    received = 0;
+    decoded = 0;
+    const int length = rf.send(messages[m][0], messages[m][1], REPEATS);
+    Serial.print(messages[m][0]);
+    Serial.print(": ");
+    Serial.print(length);
+    Serial.print(" pulses, ");
+    Serial.print(ESPiLight::simulatedEdges() - recorded);
+    Serial.print(" edges, ");
+    Serial.print(ESPiLight::simulationTime() - start);
+    Serial.println(" us on air");
+    Serial.print("  received ");
+    Serial.println(first);
+    // loop() decodes one received pulse train per call
+    for (int i = 0; i <= REPEATS; i++) {
+      rf.loop();
+    }
+    Serial.print("  received ");
+    Serial.print(received);
+    Serial.print(" of ");
+    Serial.print(REPEATS);
+    Serial.print(" repeats, ");
+    Serial.print(decoded);
+    Serial.println(" decoded messages");
+    const EchoStats_t stats = ESPiLight::echoStats(messages[m][0]);
+    Serial.print("  verified ");
+    Serial.print(stats.confirmed);
+    Serial.print(" of ");
+    Serial.print(stats.transmissions);
+    Serial.print(" transmissions, ");
+    Serial.print(stats.echoes);
+    Serial.println(" echoes");
+  }
+
+  // the first edges of the timeline
+  for (unsigned int i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+    Serial.print(edges[i].time);
+    Serial.print(' ');
+    Serial.println(edges[i].level);
+  }
+  ESPiLight::endSimulation();
+}
+
+void loop() {
+  // nothing
+}
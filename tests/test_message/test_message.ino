@@ -0,0 +1,55 @@
+/*
+ Basic ESPiLight message buffer test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define PROTOCOL "pollin"
+#define JMESSAGE "{\"systemcode\":21,\"unitcode\":3,\"on\":1}"
+
+ESPiLight rf(-1);  // use -1 to disable transmitter
+
+char buffer[64];
+char shortBuffer[16];
+
+// callback function. message is encoded into the buffer
+void messageCallback(const char *protocol, const char *message, size_t length,
+                     int status, size_t repeats) {
+  Serial.print("message [");
+  Serial.print(protocol);
+  Serial.print("] (");
+  Serial.print(length);
+  Serial.print(") ");
+  if (message != nullptr) {
+    Serial.print(message);
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  uint16_t pulses[MAXPULSESTREAMLENGTH];
+  int length = ESPiLight::createPulseTrain(pulses, PROTOCOL, JMESSAGE);
+  rf.limitProtocols("[\"" PROTOCOL "\"]");
+
+  rf.setMessageCallback(messageCallback, buffer, sizeof(buffer));
+  Serial.println("Into buffer:");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+
+  // length (should be 43) is not less than the size, message is truncated
+  rf.setMessageCallback(messageCallback, shortBuffer, sizeof(shortBuffer));
+  Serial.println("Into short buffer:");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+
+  // message is printed before the callback
+  rf.setMessageCallback(messageCallback, Serial);
+  Serial.println("To Serial:");
+  rf.parsePulseTrain(pulses, (uint8_t)length);
+}
+
+void loop() {
+  // nothing
+}
@@ -0,0 +1,84 @@
+/*
+ Basic ESPiLight receiver test: pulse trains are passed edge by edge to the
+ receiver and must decode like the pulse trains themselves
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define REPEATS 2
+
+const char *const messages[][2] = {
+    {"elro_800_switch", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+    {"elro_400_switch", "{\"systemcode\":17,\"unitcode\":1,\"off\":1}"},
+    {"pollin", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+    {"mumbi", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+    {"silvercrest", "{\"systemcode\":17,\"unitcode\":1,\"on\":1}"},
+    {"clarus_switch", "{\"id\":\"A1\",\"unit\":1,\"on\":1}"},
+    {"beamish_switch", "{\"id\":1234,\"unit\":1,\"on\":1}"},
+    {"ehome", "{\"id\":1,\"on\":1}"},
+};
+
+ESPiLight rf(-1);  // use -1 to disable transmitter
+String decoded;
+size_t count = 0;
+
+// callback function. It is called on successfully received and parsed rc signal
+void rfCallback(const String &protocol, const String &message, int status,
+                size_t repeats, const String &deviceID) {
+  decoded += protocol;
+  decoded += message;
+  decoded += ' ';
+  count++;
+}
+
+void setup() {
+  Serial.begin(115200);
+  rf.setCallback(rfCallback);
+  ESPiLight::enableReceiver();
+
+  unsigned long at = 0;
+  for (unsigned int m = 0; m < sizeof(messages) / sizeof(messages[0]); m++) {
+    uint16_t pulses[MAXPULSESTREAMLENGTH];
+    const int length =
+        ESPiLight::createPulseTrain(pulses, messages[m][0], messages[m][1]);
+
+    decoded = "";
+    count = 0;
+    rf.parsePulseTrain(pulses, (uint8_t)length);
+    const String expected = decoded;
+    const size_t messageCount = count;
+
+    // silence, then the repeats, ended by the edge after the last footer
+    at += 100000;
+    ESPiLight::receiveEdge(at);
+    for (int r = 0; r < REPEATS; r++) {
+      for (int i = 0; i < length; i++) {
+        at += pulses[i];
+        ESPiLight::receiveEdge(at);
+      }
+    }
+    // loop() decodes one received pulse train per call
+    size_t matched = 0;
+    for (int r = 0; r <= REPEATS; r++) {
+      decoded = "";
+      rf.loop();
+      if (decoded.length() > 0 && decoded == expected) {
+        matched++;
+      }
+    }
+    Serial.print(messages[m][0]);
+    Serial.print(": ");
+    Serial.print(matched);
+    Serial.print(" of ");
+    Serial.print(REPEATS);
+    Serial.print(" repeats decoded like the pulse train (");
+    Serial.print(messageCount);
+    Serial.println(" messages)");
+  }
+}
+
+void loop() {
+  // nothing
+}
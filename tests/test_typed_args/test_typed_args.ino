@@ -0,0 +1,47 @@
+/*
+ Basic ESPiLight typed message test
+
+ https://github.com/puuu/espilight
+*/
+
+#include <ESPiLight.h>
+
+#define PROTOCOL "arctech_switch"
+#define JMESSAGE "{\"id\":1234,\"unit\":1,\"on\":1}"
+
+void printMissing(const char **missing, size_t maxMissing) {
+  Serial.print("missing:");
+  for (size_t i = 0; i < maxMissing && missing[i] != nullptr; i++) {
+    Serial.print(' ');
+    Serial.print(missing[i]);
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  uint16_t typed[MAXPULSESTREAMLENGTH];
+  uint16_t json[MAXPULSESTREAMLENGTH];
+  const char *missing[4];
+  struct protocol_t *protocol = ESPiLight::findProtocol(PROTOCOL);
+
+  // same message as JMESSAGE, without json
+  const PilightArg_t args[] = {{"id", 1234}, {"unit", 1}, {"on", 1}};
+  int length = ESPiLight::createPulseTrain(typed, protocol, args, 3);
+  int jlength = ESPiLight::createPulseTrain(json, PROTOCOL, JMESSAGE);
+  Serial.print("typed and json pulse trains are equal (should be 1): ");
+  Serial.println(length == jlength &&
+                 memcmp(typed, json, length * sizeof(uint16_t)) == 0);
+
+  // id and state are missing
+  const PilightArg_t incomplete[] = {{"unit", 1}};
+  Serial.print("incomplete message (should be -1): ");
+  Serial.println(
+      ESPiLight::createPulseTrain(typed, protocol, incomplete, 1, missing, 4));
+  printMissing(missing, 4);  // should be: id on off
+}
+
+void loop() {
+  // nothing
+}